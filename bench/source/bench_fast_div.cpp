@@ -0,0 +1,47 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <cstdint>
+#include <ldsgen/fast_div.hpp>
+#include <ldsgen/ilds.hpp>
+#include <ldsgen/lds.hpp>
+#include <ldsgen/lds_n.hpp>
+#include <string>
+#include <vector>
+
+namespace nb = ankerl::nanobench;
+
+auto main() -> int {
+    {
+        auto bench = nb::Bench().title("Division by a runtime divisor").relative(true);
+        bench.minEpochIterations(1000000);
+        // read the divisor through a volatile so that it is not folded into a constant
+        volatile std::uint64_t opaque = 7;
+        const std::uint64_t divisor = opaque;
+        const auto fast = ldsgen::FastDivider(divisor);
+        auto numer = std::uint64_t{1} << 40U;
+        bench.run("hardware n / d", [&] { nb::doNotOptimizeAway(numer++ / divisor); });
+        bench.run("FastDivider n / d", [&] { nb::doNotOptimizeAway(numer++ / fast); });
+    }
+    {
+        auto bench = nb::Bench().title("VdCorput::pop() at index 2^40").relative(true);
+        bench.minEpochIterations(1000000);
+        for (const unsigned long base : {3UL, 7UL, 1009UL}) {
+            auto vdc = ldsgen::VdCorput(base);
+            vdc.reseed(1UL << 40U);
+            bench.run("VdCorput(" + std::to_string(base) + ").pop()",
+                      [&] { nb::doNotOptimizeAway(vdc.pop()); });
+        }
+        auto ivdc = ildsgen::VdCorput(3, 30);
+        ivdc.reseed(1UL << 40U);
+        bench.run("ildsgen::VdCorput(3, 30).pop()", [&] { nb::doNotOptimizeAway(ivdc.pop()); });
+    }
+    {
+        auto bench = nb::Bench().title("HaltonN with the first 50 primes");
+        auto bases = std::vector<unsigned long>(ldsgen::PRIME_TABLE.begin(),
+                                                ldsgen::PRIME_TABLE.begin() + 50);
+        auto hgen = ldsgen::HaltonN(bases);
+        hgen.reseed(1000000);
+        bench.run("HaltonN(50).pop()", [&] { nb::doNotOptimizeAway(hgen.pop()); });
+    }
+}
@@ -0,0 +1,375 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <ldsgen/lds.hpp>
+#include <ldsgen/lds_n.hpp>
+#include <ldsgen/parallel.hpp>
+#include <ldsgen/sphere_n.hpp>
+#include <ldsgen/unit_roots.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nb = ankerl::nanobench;
+
+namespace {
+
+    template <typename Gen> void bench_pop(nb::Bench& bench, const char* name, Gen& gen) {
+        bench.run(name, [&] { nb::doNotOptimizeAway(gen.pop()); });
+    }
+
+    // Runs `work` on `num_threads` threads at once and waits for all of them.
+    template <typename Work> void run_threads(unsigned int num_threads, Work work) {
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(num_threads);
+        for (unsigned int i = 0; i < num_threads; ++i) {
+            threads.emplace_back(work);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // The mapping function tp(n) at x, in long double
+    auto tp_exact(unsigned int n, long double x) -> long double {
+        const bool odd = n % 2 != 0;
+        const long double sine = std::sin(x);
+        const long double cosine = std::cos(x);
+        long double value = odd ? -cosine : x;
+        long double power = odd ? sine * sine : sine;
+        for (unsigned int k = odd ? 3 : 2; k <= n; k += 2) {
+            value = ((k - 1) * value - cosine * power) / k;
+            power *= sine * sine;
+        }
+        return value;
+    }
+
+    // The angle x in [0, pi] with tp(n) = t, by bisection
+    auto inverse_exact(unsigned int n, double t) -> long double {
+        long double lo = 0.0L;
+        long double hi = ldsgen::PI;
+        for (int i = 0; i < 100; ++i) {
+            const auto mid = (lo + hi) / 2;
+            (tp_exact(n, mid) < t ? lo : hi) = mid;
+        }
+        return (lo + hi) / 2;
+    }
+
+}  // namespace
+
+auto main() -> int {
+    {
+        auto bench = nb::Bench().title("VdCorput: runtime vs compile-time base").relative(true);
+        bench.minEpochIterations(1000000);
+        auto vdc3 = ldsgen::VdCorput(3);
+        auto vdct3 = ldsgen::VdCorputT<3>();
+        auto vdc7 = ldsgen::VdCorput(7);
+        auto vdct7 = ldsgen::VdCorputT<7>();
+        bench_pop(bench, "VdCorput(3).pop()", vdc3);
+        bench_pop(bench, "VdCorputT<3>.pop()", vdct3);
+        bench_pop(bench, "VdCorput(7).pop()", vdc7);
+        bench_pop(bench, "VdCorputT<7>.pop()", vdct7);
+    }
+    {
+        auto bench
+            = nb::Bench().title("VdCorput: atomic vs single-threaded counter").relative(true);
+        bench.minEpochIterations(1000000);
+        auto vdc = ldsgen::VdCorput(3);
+        auto lvdc = ldsgen::LocalVdCorput(3);
+        auto halton = ldsgen::Halton(2, 3);
+        auto lhalton = ldsgen::LocalHalton(2, 3);
+        bench_pop(bench, "VdCorput(3).pop()", vdc);
+        bench_pop(bench, "LocalVdCorput(3).pop()", lvdc);
+        bench_pop(bench, "Halton(2, 3).pop()", halton);
+        bench_pop(bench, "LocalHalton(2, 3).pop()", lhalton);
+    }
+    {
+        auto bench = nb::Bench().title("Composites: runtime vs compile-time bases").relative(true);
+        bench.minEpochIterations(1000000);
+        auto halton = ldsgen::Halton(3, 5);
+        auto haltont = ldsgen::HaltonT<3, 5>();
+        auto sphere = ldsgen::Sphere(3, 5);
+        auto spheret = ldsgen::SphereT<3, 5>();
+        bench_pop(bench, "Halton(3, 5).pop()", halton);
+        bench_pop(bench, "HaltonT<3, 5>.pop()", haltont);
+        bench_pop(bench, "Sphere(3, 5).pop()", sphere);
+        bench_pop(bench, "SphereT<3, 5>.pop()", spheret);
+    }
+    {
+        auto bench = nb::Bench().title("Batch fill of 4096 points").relative(true);
+        auto vdc = ldsgen::VdCorput(3);
+        auto vdct = ldsgen::VdCorputT<3>();
+        auto halton = ldsgen::Halton(3, 5);
+        auto values = std::vector<double>(4096);
+        auto points = std::vector<std::array<double, 2>>(4096);
+        bench.batch(values.size());
+        bench.run("VdCorput(3) pop() loop", [&] {
+            for (auto& value : values) {
+                value = vdc.pop();
+            }
+            nb::doNotOptimizeAway(values.data());
+        });
+        bench.run("VdCorput(3).fill()", [&] {
+            vdc.fill(values);
+            nb::doNotOptimizeAway(values.data());
+        });
+        bench.run("VdCorputT<3>.fill()", [&] {
+            vdct.fill(values);
+            nb::doNotOptimizeAway(values.data());
+        });
+        bench.run("Halton(3, 5).fill()", [&] {
+            halton.fill(points);
+            nb::doNotOptimizeAway(points.data());
+        });
+    }
+    {
+        auto title = std::string("HaltonN batch fill of 4096 points, ") + ldsgen::vdc_kernel_name()
+                     + " kernel";
+        auto bench = nb::Bench().title(title);
+        auto hgen = ldsgen::HaltonN({2, 3, 5, 7, 11, 13, 17, 19});
+        auto values = std::vector<double>(4096 * 8);
+        bench.batch(4096);
+        bench.run("HaltonN(8).fill()", [&] {
+            hgen.fill(values);
+            nb::doNotOptimizeAway(values.data());
+        });
+    }
+    {
+        auto bench = nb::Bench().title("HaltonN single point, 50 dimensions").relative(true);
+        auto bases = std::vector<unsigned long>(ldsgen::PRIME_TABLE.begin(),
+                                                ldsgen::PRIME_TABLE.begin() + 50);
+        auto hgen = ldsgen::HaltonN(bases);
+        auto engines = std::vector<ldsgen::RadicalInverse>(bases.begin(), bases.end());
+        auto point = std::vector<double>(bases.size());
+        auto index = 1000000UL;
+        bench.run("RadicalInverse::at() per dimension", [&] {
+            for (std::size_t j = 0; j < bases.size(); ++j) {
+                point[j] = engines[j].at(index);
+            }
+            nb::doNotOptimizeAway(point.data());
+            ++index;
+        });
+        bench.run("HaltonN::at(index, span) lockstep", [&] {
+            hgen.at(index++, point);
+            nb::doNotOptimizeAway(point.data());
+        });
+    }
+    {
+        const auto num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        constexpr std::size_t POINTS_PER_THREAD = 1U << 16U;
+        auto title = std::string("Shared Sphere(2, 3), ") + std::to_string(num_threads)
+                     + " threads";
+        auto bench = nb::Bench().title(title).relative(true);
+        bench.batch(num_threads * POINTS_PER_THREAD);
+        auto sgen = ldsgen::Sphere(2, 3);
+        bench.run("pop() on the shared generator", [&] {
+            run_threads(num_threads, [&] {
+                for (std::size_t i = 0; i < POINTS_PER_THREAD; ++i) {
+                    nb::doNotOptimizeAway(sgen.pop());
+                }
+            });
+        });
+        bench.run("BlockCursor::pop()", [&] {
+            run_threads(num_threads, [&] {
+                auto cursor = ldsgen::BlockCursor(sgen);
+                for (std::size_t i = 0; i < POINTS_PER_THREAD; ++i) {
+                    nb::doNotOptimizeAway(cursor.pop());
+                }
+            });
+        });
+    }
+    {
+        const auto num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        auto title = std::string("Sphere(2, 3) batch of 2^20 points, ")
+                     + std::to_string(num_threads) + " threads";
+        auto bench = nb::Bench().title(title).relative(true);
+        auto sgen = ldsgen::Sphere(2, 3);
+        auto points = std::vector<std::array<double, 3>>(1U << 20U);
+        bench.batch(points.size());
+        bench.run("Sphere(2, 3).fill(start, out)", [&] {
+            sgen.fill(0, points);
+            nb::doNotOptimizeAway(points.data());
+        });
+        bench.run("parallel_fill(Sphere(2, 3), start, out)", [&] {
+            ldsgen::parallel_fill(sgen, 0, points);
+            nb::doNotOptimizeAway(points.data());
+        });
+    }
+    {
+        auto bench
+            = nb::Bench().title("Batch fill of 4096 points: sincos kernel vs roots of unity").relative(true);
+        auto circle = std::vector<std::array<double, 2>>(4096);
+        auto sphere = std::vector<std::array<double, 3>>(4096);
+        auto sphere3 = std::vector<std::array<double, 4>>(4096);
+        const auto cgen = ldsgen::Circle(3);
+        const auto tcgen = ldsgen::TrigFreeCircle(3);
+        const auto sgen = ldsgen::Sphere(2, 3);
+        const auto tsgen = ldsgen::TrigFreeSphere(2, 3);
+        const auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+        const auto tshfgen = ldsgen::TrigFreeSphere3Hopf(2, 3, 5);
+        bench.batch(circle.size());
+        bench.run("Circle(3).fill(start, out)", [&] {
+            cgen.fill(1000, circle);
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("TrigFreeCircle(3).fill(start, out)", [&] {
+            tcgen.fill(1000, circle);
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("Sphere(2, 3).fill(start, out)", [&] {
+            sgen.fill(1000, sphere);
+            nb::doNotOptimizeAway(sphere.data());
+        });
+        bench.run("TrigFreeSphere(2, 3).fill(start, out)", [&] {
+            tsgen.fill(1000, sphere);
+            nb::doNotOptimizeAway(sphere.data());
+        });
+        bench.run("Sphere3Hopf(2, 3, 5).fill(start, out)", [&] {
+            shfgen.fill(1000, sphere3);
+            nb::doNotOptimizeAway(sphere3.data());
+        });
+        bench.run("TrigFreeSphere3Hopf(2, 3, 5).fill(start, out)", [&] {
+            tshfgen.fill(1000, sphere3);
+            nb::doNotOptimizeAway(sphere3.data());
+        });
+    }
+    {
+        // the scalar path the generators took before the sincos kernel
+        auto title = std::string("Batch fill of 4096 points: std::cos/std::sin vs ")
+                     + ldsgen::sincos_kernel_name() + " sincos kernel";
+        auto bench = nb::Bench().title(title).relative(true);
+        auto vdc0 = std::vector<double>(4096);
+        auto vdc1 = std::vector<double>(4096);
+        auto vdc2 = std::vector<double>(4096);
+        auto circle = std::vector<std::array<double, 2>>(4096);
+        auto sphere = std::vector<std::array<double, 3>>(4096);
+        auto sphere3 = std::vector<std::array<double, 4>>(4096);
+        const auto vgen2 = ldsgen::VdCorput(2);
+        const auto vgen3 = ldsgen::VdCorput(3);
+        const auto vgen5 = ldsgen::VdCorput(5);
+        const auto cgen = ldsgen::Circle(3);
+        const auto dgen = ldsgen::Disk(3, 2);
+        const auto sgen = ldsgen::Sphere(2, 3);
+        const auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+        bench.batch(circle.size());
+        bench.run("Circle(3), std::cos/std::sin", [&] {
+            vgen3.fill(1000, vdc1);
+            for (std::size_t i = 0; i < circle.size(); ++i) {
+                const auto theta = vdc1[i] * ldsgen::TWO_PI;
+                circle[i] = {std::cos(theta), std::sin(theta)};
+            }
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("Circle(3).fill(start, out)", [&] {
+            cgen.fill(1000, circle);
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("Disk(3, 2), std::cos/std::sin/std::sqrt", [&] {
+            vgen3.fill(1000, vdc0);
+            vgen2.fill(1000, vdc1);
+            for (std::size_t i = 0; i < circle.size(); ++i) {
+                const auto theta = vdc0[i] * ldsgen::TWO_PI;
+                const auto radius = std::sqrt(vdc1[i]);
+                circle[i] = {radius * std::cos(theta), radius * std::sin(theta)};
+            }
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("Disk(3, 2).fill(start, out)", [&] {
+            dgen.fill(1000, circle);
+            nb::doNotOptimizeAway(circle.data());
+        });
+        bench.run("Sphere(2, 3), std::cos/std::sin/std::sqrt", [&] {
+            vgen2.fill(1000, vdc0);
+            vgen3.fill(1000, vdc1);
+            for (std::size_t i = 0; i < sphere.size(); ++i) {
+                const auto cosphi = 2.0 * vdc0[i] - 1.0;
+                const auto sinphi = std::sqrt(1.0 - cosphi * cosphi);
+                const auto theta = vdc1[i] * ldsgen::TWO_PI;
+                sphere[i] = {sinphi * std::cos(theta), sinphi * std::sin(theta), cosphi};
+            }
+            nb::doNotOptimizeAway(sphere.data());
+        });
+        bench.run("Sphere(2, 3).fill(start, out)", [&] {
+            sgen.fill(1000, sphere);
+            nb::doNotOptimizeAway(sphere.data());
+        });
+        bench.run("Sphere3Hopf(2, 3, 5), std::cos/std::sin/std::sqrt", [&] {
+            vgen2.fill(1000, vdc0);
+            vgen3.fill(1000, vdc1);
+            vgen5.fill(1000, vdc2);
+            for (std::size_t i = 0; i < sphere3.size(); ++i) {
+                const auto phi = vdc0[i] * ldsgen::TWO_PI;
+                const auto psy = vdc1[i] * ldsgen::TWO_PI;
+                const auto cos_eta = std::sqrt(vdc2[i]);
+                const auto sin_eta = std::sqrt(1.0 - vdc2[i]);
+                sphere3[i] = {cos_eta * std::cos(psy), cos_eta * std::sin(psy),
+                              sin_eta * std::cos(phi + psy), sin_eta * std::sin(phi + psy)};
+            }
+            nb::doNotOptimizeAway(sphere3.data());
+        });
+        bench.run("Sphere3Hopf(2, 3, 5).fill(start, out)", [&] {
+            shfgen.fill(1000, sphere3);
+            nb::doNotOptimizeAway(sphere3.data());
+        });
+    }
+    for (unsigned int n : {2U, 16U}) {
+        // the inverse of the mapping function, as SphereN looks up each level
+        auto title = std::string("Inverse of tp_table(") + std::to_string(n)
+                     + ") at 4096 values: simple_interp vs TpLookup";
+        auto bench = nb::Bench().title(title).relative(true);
+        const auto x_points = ldsgen::tp_table(0);
+        const auto tp = ldsgen::tp_table(n);
+        const auto& lookup = ldsgen::tp_lookup(n);
+        auto values = std::vector<double>(4096);
+        ldsgen::VdCorput(3).fill(1000, values);
+        for (auto& t : values) {
+            t = tp.front() + (tp.back() - tp.front()) * t;
+        }
+        bench.batch(values.size());
+        bench.run("simple_interp(t, tp, x)", [&] {
+            double sum = 0.0;
+            for (double t : values) {
+                sum += ldsgen::simple_interp(t, tp, x_points);
+            }
+            nb::doNotOptimizeAway(sum);
+        });
+        bench.run("lookup(t)", [&] {
+            double sum = 0.0;
+            for (double t : values) {
+                sum += lookup(t);
+            }
+            nb::doNotOptimizeAway(sum);
+        });
+        bench.run("lookup.refined(t)", [&] {
+            double sum = 0.0;
+            for (double t : values) {
+                sum += lookup.refined(t);
+            }
+            nb::doNotOptimizeAway(sum);
+        });
+        // worst error against the exact inverse, over all values and over
+        // those of the middle 98% of the range (away from the poles)
+        std::array<long double, 4> errors{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const auto exact = inverse_exact(n, values[i]);
+            const auto interp_error
+                = std::abs(ldsgen::simple_interp(values[i], tp, x_points) - exact);
+            const auto refined_error = std::abs(lookup.refined(values[i]) - exact);
+            errors[0] = std::max(errors[0], interp_error);
+            errors[1] = std::max(errors[1], refined_error);
+            const auto u = (values[i] - tp.front()) / (tp.back() - tp.front());
+            if (u > 0.01 && u < 0.99) {
+                errors[2] = std::max(errors[2], interp_error);
+                errors[3] = std::max(errors[3], refined_error);
+            }
+        }
+        std::printf("max error, n = %u: interpolated %.2Le (%.2Le inside),"
+                    " refined %.2Le (%.2Le inside)\n",
+                    n, errors[0], errors[2], errors[1], errors[3]);
+    }
+    return 0;
+}
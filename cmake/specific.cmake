@@ -8,5 +8,8 @@ CPMAddPackage(
   OPTIONS "SPDLOG_INSTALL YES" # create an installable target
 )
 
+# parallel_fill runs on std::thread
+find_package(Threads REQUIRED)
+
 # Define specific libs to be linked to library and targets
-set(SPECIFIC_LIBS fmt::fmt spdlog::spdlog)
+set(SPECIFIC_LIBS fmt::fmt spdlog::spdlog Threads::Threads)
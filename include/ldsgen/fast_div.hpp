@@ -0,0 +1,125 @@
+#pragma once
+
+/** @file fast_div.hpp
+ *  @brief Division by a runtime-invariant divisor via multiply-shift (libdivide style).
+ */
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#    include <intrin.h>
+#endif
+
+namespace ldsgen {
+
+    /**
+     * @brief High 64 bits of the 128-bit product of two 64-bit words
+     *
+     * @param[in] lhs the first factor
+     * @param[in] rhs the second factor
+     * @return std::uint64_t
+     */
+    constexpr auto mul_hi(std::uint64_t lhs, std::uint64_t rhs) -> std::uint64_t {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using uint128_t = unsigned __int128;
+        return static_cast<std::uint64_t>((static_cast<uint128_t>(lhs) * rhs) >> 64U);
+#else
+#    if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+        if (!std::is_constant_evaluated()) {
+            return __umulh(lhs, rhs);
+        }
+#    endif
+        const std::uint64_t lhs_lo = lhs & 0xFFFFFFFFU;
+        const std::uint64_t lhs_hi = lhs >> 32U;
+        const std::uint64_t rhs_lo = rhs & 0xFFFFFFFFU;
+        const std::uint64_t rhs_hi = rhs >> 32U;
+        const std::uint64_t lo_lo = lhs_lo * rhs_lo;
+        const std::uint64_t hi_lo = lhs_hi * rhs_lo;
+        const std::uint64_t lo_hi = lhs_lo * rhs_hi;
+        const std::uint64_t cross = (lo_lo >> 32U) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+        return lhs_hi * rhs_hi + (hi_lo >> 32U) + (cross >> 32U);
+#endif
+    }
+
+    /**
+     * @brief Unsigned 64-bit division by a runtime-invariant divisor
+     *
+     * Precomputes a magic multiplier and a shift at construction (the
+     * "branchfree" scheme of libdivide, after Granlund and Montgomery), so
+     * that every later division costs one multiply-high, a subtraction and
+     * two shifts instead of a hardware `div`. This pays off whenever the same
+     * divisor is used many times, as the base of a Van der Corput sequence is.
+     *
+     * @verbatim
+     *     FastDivider d(7);
+     *     100 / d -> 14
+     *     100 % d -> 2
+     * @endverbatim
+     */
+    class FastDivider {
+        std::uint64_t divisor;
+        std::uint64_t magic;
+        unsigned int shift;
+
+      public:
+        /**
+         * @brief Construct a new FastDivider object
+         *
+         * @param[in] divisor the divisor, which must be at least 2
+         */
+        constexpr explicit FastDivider(const std::uint64_t divisor)
+            : divisor{divisor}, magic{1}, shift{0} {
+            // ceil(log2(divisor))
+            const auto log2_ceil = static_cast<unsigned int>(64 - std::countl_zero(divisor - 1));
+            // magic = floor(2^64 * (2^log2_ceil - divisor) / divisor) + 1, by long division
+            std::uint64_t rem = (log2_ceil == 64 ? 0 : (std::uint64_t{1} << log2_ceil)) - divisor;
+            std::uint64_t quot = 0;
+            for (unsigned int i = 0; i < 64; ++i) {
+                const auto carry = rem >> 63U;
+                rem <<= 1U;
+                quot <<= 1U;
+                if (carry != 0 || rem >= divisor) {
+                    rem -= divisor;
+                    quot |= 1U;
+                }
+            }
+            this->magic = quot + 1;
+            this->shift = log2_ceil - 1;
+        }
+
+        /**
+         * @brief Get the divisor
+         *
+         * @return std::uint64_t
+         */
+        [[nodiscard]] constexpr auto get_divisor() const -> std::uint64_t { return this->divisor; }
+
+        /**
+         * @brief Divide a number by the divisor
+         *
+         * @param[in] numer the dividend
+         * @param[in] div the divider
+         * @return std::uint64_t the quotient
+         */
+        friend constexpr auto operator/(const std::uint64_t numer, const FastDivider& div)
+            -> std::uint64_t {
+            const auto hi = mul_hi(div.magic, numer);
+            return (((numer - hi) >> 1U) + hi) >> div.shift;
+        }
+
+        /**
+         * @brief Remainder of a number divided by the divisor
+         *
+         * @param[in] numer the dividend
+         * @param[in] div the divider
+         * @return std::uint64_t the remainder
+         */
+        friend constexpr auto operator%(const std::uint64_t numer, const FastDivider& div)
+            -> std::uint64_t {
+            return numer - (numer / div) * div.divisor;
+        }
+    };
+
+}  // namespace ldsgen
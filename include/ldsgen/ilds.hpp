@@ -7,6 +7,8 @@
 #include <array>
 #include <atomic>
 
+#include "fast_div.hpp"
+
 namespace ildsgen {
 
     using std::array;
@@ -29,6 +31,7 @@ namespace ildsgen {
      */
     class VdCorput {
         unsigned long _base;                ///< Base of the number system
+        ldsgen::FastDivider _divider;       ///< Multiply-shift division by the base
         std::atomic<unsigned long> _count;  ///< Current count in the sequence
         // unsigned long _factor;              ///< Precomputed scale factor (base^scale)
         std::array<unsigned long, MAX_REVERSE_BITS>
@@ -44,7 +47,7 @@ namespace ildsgen {
          * @param[in] scale The number of digits (default: 10)
          */
         explicit VdCorput(unsigned long base = 2, unsigned int scale = DEFAULT_SCALE)
-            : _base{base}, _count{0}, factor_lst{} {
+            : _base{base}, _divider{base}, _count{0}, factor_lst{} {
             unsigned long factor = 1;
             for (unsigned int i = 0; i < scale; ++i) {
                 factor *= _base;
@@ -67,8 +70,9 @@ namespace ildsgen {
             unsigned long reslt = 0;
             unsigned int idx = 0;
             while (count != 0) {
-                const unsigned long remainder = count % this->_base;
-                count /= this->_base;
+                const auto quotient = static_cast<unsigned long>(count / this->_divider);
+                const unsigned long remainder = count - quotient * this->_base;
+                count = quotient;
                 reslt += remainder * this->factor_lst[idx];
                 ++idx;
             }
@@ -84,8 +88,37 @@ namespace ildsgen {
             this->_count.store(seed, std::memory_order_relaxed);
         }
 
-        VdCorput(VdCorput&&) noexcept = delete;
-        VdCorput& operator=(VdCorput&&) noexcept = delete;
+        /**
+         * @brief Copy the generator, with a snapshot of its count
+         *
+         * @param[in] other the generator to copy
+         */
+        VdCorput(const VdCorput& other) noexcept
+            : _base{other._base},
+              _divider{other._divider},
+              _count{other._count.load(std::memory_order_relaxed)},
+              factor_lst{other.factor_lst} {}
+
+        auto operator=(const VdCorput& other) noexcept -> VdCorput& {
+            this->_base = other._base;
+            this->_divider = other._divider;
+            this->_count.store(other._count.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+            this->factor_lst = other.factor_lst;
+            return *this;
+        }
+
+        /**
+         * @brief Copy the generator, positioned at a given count
+         *
+         * @param[in] start the count the copy starts from
+         * @return VdCorput
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> VdCorput {
+            auto copy = *this;
+            copy.reseed(start);
+            return copy;
+        }
     };
 
     /**
@@ -139,6 +172,18 @@ namespace ildsgen {
             this->vdc0.reseed(seed);
             this->vdc1.reseed(seed);
         }
+
+        /**
+         * @brief Copy the generator, positioned at a given count
+         *
+         * @param[in] start the count both dimensions start from
+         * @return Halton
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> Halton {
+            auto copy = *this;
+            copy.reseed(start);
+            return copy;
+        }
     };
 
 }  // namespace ildsgen
@@ -4,11 +4,24 @@
  *  @brief Low-discrepancy sequence generators with thread-safe runtime polymorphism (ldsgen).
  */
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fast_div.hpp"
+#include "soa.hpp"
 
 #ifndef M_PI
 #    define M_PI 3.14159265358979323846264338327950288
@@ -21,12 +34,26 @@ namespace ldsgen {
     // Constants for magic numbers
     constexpr unsigned int MAX_REVERSE_BITS = 64;
     constexpr double MAPPING_FACTOR = 2.0;
+    /// Maximum number of entries of a digit-chunk table (8 KiB of doubles, L1 resident)
+    constexpr unsigned long CHUNK_TABLE_SIZE = 1024;
+    /// Largest base that gets a digit-chunk table (it must hold two digits at least)
+    constexpr unsigned long MAX_CHUNK_BASE = 32;
+    /// Number of points a composite batch fill generates per dimension at a time
+    constexpr std::size_t FILL_BLOCK = 256;
+    /// Size of a cache line, the unit of false sharing between cores
+    constexpr std::size_t CACHE_LINE_SIZE = 64;
+    /// Default number of indices a `BlockCursor` claims at a time
+    constexpr std::size_t CURSOR_BLOCK = 4096;
 
     /**
-     * @brief Forward iterator for sequence generators
+     * @brief Stateless random-access iterator over a sequence
      *
-     * Provides STL-compatible iterator interface for all generators.
-     * Allows use in range-based for loops and STL algorithms.
+     * Dereferencing computes the point at the iterator's index with the
+     * generator's `at()`; it never touches the generator's counter. Iterators
+     * are therefore cheap to copy, split and advance, and any number of them
+     * can be read concurrently, e.g. by `std::transform(std::execution::par_unseq,
+     * ...)` or `std::ranges` algorithms. Dereferencing yields a value, not a
+     * reference.
      *
      * @verbatim
      * VdCorput gen(2);
@@ -36,42 +63,30 @@ namespace ldsgen {
      * @tparam Generator The generator class
      * @tparam Value The value type (double or array)
      */
-    /**
-     * @brief Forward iterator for sequence generators.
-     *
-     * Provides STL-compatible iterator interface for all generators.
-     * Allows use in range-based for loops and STL algorithms.
-     *
-     * @tparam Generator The generator class type.
-     * @tparam Value The value type (double or array).
-     */
     template <typename Generator, typename Value> class GeneratorIterator {
-        Generator* gen;
+        const Generator* gen;
         unsigned long index;
 
       public:
-        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
         using value_type = Value;
         using difference_type = std::ptrdiff_t;
         using pointer = const value_type*;
         using reference = value_type;
 
-        explicit GeneratorIterator(Generator* g = nullptr, unsigned long idx = 0)
+        explicit GeneratorIterator(const Generator* g = nullptr, unsigned long idx = 0)
             : gen{g}, index{idx} {}
 
         /**
          * @brief Dereference operator
          */
-        auto operator*() const -> Value {
-            if (gen) {
-                auto temp_idx = gen->get_index();
-                gen->reseed(index);
-                auto value = gen->pop();
-                gen->reseed(temp_idx);
-                return value;
-            }
-            return Value{};
-        }
+        auto operator*() const -> Value { return gen ? gen->at(index) : Value{}; }
+
+        /**
+         * @brief Subscript operator
+         */
+        auto operator[](difference_type n) const -> Value { return *(*this + n); }
 
         /**
          * @brief Pre-increment operator
@@ -90,6 +105,59 @@ namespace ldsgen {
             return temp;
         }
 
+        /**
+         * @brief Pre-decrement operator
+         */
+        auto operator--() -> GeneratorIterator& {
+            --index;
+            return *this;
+        }
+
+        /**
+         * @brief Post-decrement operator
+         */
+        auto operator--(int) -> GeneratorIterator {
+            auto temp = *this;
+            --index;
+            return temp;
+        }
+
+        /**
+         * @brief Advance by n points
+         */
+        auto operator+=(difference_type n) -> GeneratorIterator& {
+            index += static_cast<unsigned long>(n);
+            return *this;
+        }
+
+        /**
+         * @brief Go back by n points
+         */
+        auto operator-=(difference_type n) -> GeneratorIterator& {
+            index -= static_cast<unsigned long>(n);
+            return *this;
+        }
+
+        friend auto operator+(GeneratorIterator it, difference_type n) -> GeneratorIterator {
+            return it += n;
+        }
+
+        friend auto operator+(difference_type n, GeneratorIterator it) -> GeneratorIterator {
+            return it += n;
+        }
+
+        friend auto operator-(GeneratorIterator it, difference_type n) -> GeneratorIterator {
+            return it -= n;
+        }
+
+        /**
+         * @brief Number of points between two iterators
+         */
+        friend auto operator-(const GeneratorIterator& lhs, const GeneratorIterator& rhs)
+            -> difference_type {
+            return static_cast<difference_type>(lhs.index - rhs.index);
+        }
+
         /**
          * @brief Equality comparison
          */
@@ -98,10 +166,10 @@ namespace ldsgen {
         }
 
         /**
-         * @brief Inequality comparison
+         * @brief Ordering by index
          */
-        auto operator!=(const GeneratorIterator& other) const -> bool {
-            return index != other.index;
+        auto operator<=>(const GeneratorIterator& other) const -> std::strong_ordering {
+            return index <=> other.index;
         }
 
         /**
@@ -110,6 +178,28 @@ namespace ldsgen {
         [[nodiscard]] auto get_index() const -> unsigned long { return index; }
     };
 
+    /**
+     * @brief Sized range over the points `first`, ..., `first + count - 1`
+     *
+     * A `std::ranges::random_access_range` and `sized_range` of
+     * `GeneratorIterator`s; it does not advance the generator.
+     *
+     * @verbatim
+     * Sphere gen(2, 3);
+     * auto points = sequence_range(gen, 1000, 4096);
+     * std::transform(std::execution::par_unseq, points.begin(), points.end(), ...);
+     * @endverbatim
+     *
+     * @param[in] gen the generator, which must outlive the range
+     * @param[in] first the index of the first point
+     * @param[in] count the number of points
+     */
+    template <typename Generator>
+    auto sequence_range(const Generator& gen, unsigned long first, std::size_t count) {
+        using Iterator = GeneratorIterator<Generator, decltype(gen.at(first))>;
+        return std::ranges::subrange(Iterator(&gen, first), Iterator(&gen, first + count));
+    }
+
     /**
      * @brief Van der Corput sequence
      *
@@ -140,6 +230,679 @@ namespace ldsgen {
         return reslt;
     }
 
+    /**
+     * @brief Reverse the order of the bits of a 64-bit word
+     *
+     * @param[in] x the word to reverse
+     * @return std::uint64_t the bit-reversed word
+     */
+    constexpr auto reverse_bits(std::uint64_t x) -> std::uint64_t {
+#if defined(__has_builtin)
+#    if __has_builtin(__builtin_bitreverse64)
+        return __builtin_bitreverse64(x);
+#    endif
+#endif
+        x = ((x >> 1U) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1U);
+        x = ((x >> 2U) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2U);
+        x = ((x >> 4U) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4U);
+        x = ((x >> 8U) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8U);
+        x = ((x >> 16U) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16U);
+        return (x >> 32U) | (x << 32U);
+    }
+
+    /**
+     * @brief Base-2 Van der Corput value by bit reversal
+     *
+     * Mirrors the binary digits of `count` around the radix point: the top 53
+     * bits of the reversed word become the significand of the result, which is
+     * then scaled by 2^-53 exactly. The result is exact (and equal to
+     * `vdc(count, 2)`) for every count below 2^53; beyond that the digits that
+     * do not fit into a double are truncated.
+     *
+     * @param[in] count index of the sequence
+     * @return double
+     */
+    constexpr auto vdc_base2(std::uint64_t count) -> double {
+        constexpr auto SCALE = 1.0 / double(1ULL << 53U);
+        return double(reverse_bits(count) >> 11U) * SCALE;
+    }
+
+    /**
+     * @brief Number of base-b digits that one digit-chunk table entry covers
+     *
+     * The largest k with b^k <= `CHUNK_TABLE_SIZE` (at least 1).
+     *
+     * @param[in] base the base of the Van der Corput sequence
+     * @return unsigned int
+     */
+    constexpr auto chunk_digits(unsigned long base) -> unsigned int {
+        unsigned int num_digits = 1;
+        for (auto radix = base; radix <= CHUNK_TABLE_SIZE / base; radix *= base) {
+            ++num_digits;
+        }
+        return num_digits;
+    }
+
+    /**
+     * @brief Radix b^k of the digit chunks of a base
+     *
+     * @param[in] base the base of the Van der Corput sequence
+     * @return unsigned long
+     */
+    constexpr auto chunk_radix(unsigned long base) -> unsigned long {
+        unsigned long radix = 1;
+        for (auto i = chunk_digits(base); i != 0; --i) {
+            radix *= base;
+        }
+        return radix;
+    }
+
+    /**
+     * @brief Reciprocal powers of a base
+     *
+     * Returns the table `{1/b, 1/b^2, 1/b^3, ...}` used to weight the digits
+     * of a count when computing its Van der Corput value.
+     *
+     * @param[in] base the base of the Van der Corput sequence
+     * @return std::array<double, MAX_REVERSE_BITS>
+     */
+    constexpr auto reciprocal_powers(unsigned long base) -> std::array<double, MAX_REVERSE_BITS> {
+        std::array<double, MAX_REVERSE_BITS> rev_lst{};
+        double reverse = 1.0;
+        for (unsigned int i = 0; i < MAX_REVERSE_BITS; ++i) {
+            reverse /= double(base);
+            rev_lst[i] = reverse;
+        }
+        return rev_lst;
+    }
+
+    /**
+     * @brief Digit-chunk table of a base
+     *
+     * Entry c is the Van der Corput value of the k-digit chunk c, with the
+     * digit contributions accumulated least significant first, like
+     * `VdCorput::at()`. It is therefore exactly the partial sum `at()` has
+     * reached after the lowest k digits of any count whose lowest chunk is c,
+     * and a count needs one division by b^k and one lookup for those k
+     * digits instead of k divisions and multiply-adds.
+     *
+     * @verbatim
+     *     make_chunk_table<3>() (k = 6, 729 entries):
+     *     [1] -> 1/3      (000001 -> 0.100000 base 3)
+     *     [3] -> 1/9      (000010 -> 0.010000 base 3)
+     *     [4] -> 4/9      (000011 -> 0.110000 base 3)
+     * @endverbatim
+     *
+     * @tparam Base the base of the Van der Corput sequence
+     * @return std::array<double, chunk_radix(Base)>
+     */
+    template <unsigned long Base>
+    constexpr auto make_chunk_table() -> std::array<double, chunk_radix(Base)> {
+        constexpr auto RADIX = chunk_radix(Base);
+        const auto rev_lst = reciprocal_powers(Base);
+        std::array<double, RADIX> chunk_lst{};
+        for (unsigned long chunk = 0; chunk < RADIX; ++chunk) {
+            double res = 0.0;
+            auto rest = chunk;
+            for (unsigned int i = 0; i < chunk_digits(Base); ++i) {
+                res += rev_lst[i] * double(rest % Base);
+                rest /= Base;
+            }
+            chunk_lst[chunk] = res;
+        }
+        return chunk_lst;
+    }
+
+    /// Digit-chunk table of a base, shared by all generators of that base
+    template <unsigned long Base>
+    inline constexpr std::array<double, chunk_radix(Base)> CHUNK_TABLE = make_chunk_table<Base>();
+
+    /**
+     * @brief Whether a base has a digit-chunk table
+     *
+     * Bases 3 to `MAX_CHUNK_BASE` have one. Code evaluated at compile time
+     * tests this rather than comparing a table address with nullptr, which
+     * GCC rejects in constant expressions under `-fsanitize=undefined`.
+     *
+     * @param[in] base the base of the Van der Corput sequence
+     * @return bool
+     */
+    constexpr auto has_chunk_table(unsigned long base) -> bool {
+        return base >= 3 && base <= MAX_CHUNK_BASE;
+    }
+
+    template <unsigned long... Offsets>
+    constexpr auto chunk_table_lookup(unsigned long base,
+                                      std::integer_sequence<unsigned long, Offsets...>)
+        -> const double* {
+        const double* chunk_lst = nullptr;
+        ((chunk_lst = (base == Offsets + 3) ? CHUNK_TABLE<Offsets + 3>.data() : chunk_lst), ...);
+        return chunk_lst;
+    }
+
+    /**
+     * @brief Digit-chunk table of a runtime base
+     *
+     * Bases with `has_chunk_table()` have one; the others (and base 2, which
+     * uses bit reversal) get nullptr.
+     *
+     * @param[in] base the base of the Van der Corput sequence
+     * @return const double* the table, `chunk_radix(base)` entries long
+     */
+    constexpr auto chunk_table(unsigned long base) -> const double* {
+        if (!has_chunk_table(base)) {
+            return nullptr;
+        }
+        return chunk_table_lookup(base,
+                                  std::make_integer_sequence<unsigned long, MAX_CHUNK_BASE - 2>{});
+    }
+
+    /**
+     * @brief Weights of the digit chunks
+     *
+     * Returns `{1, 1/b^k, 1/b^2k, ...}`: the chunk table already scales a
+     * chunk into [0, 1). Summing weighted chunks is exact only in base 2
+     * (`CHUNK_TABLE<2>`), where `HaltonLanes` uses it for all digits.
+     *
+     * @param[in] radix the chunk radix b^k
+     * @return std::array<double, MAX_REVERSE_BITS>
+     */
+    constexpr auto chunk_weights(unsigned long radix) -> std::array<double, MAX_REVERSE_BITS> {
+        std::array<double, MAX_REVERSE_BITS> rev_lst{};
+        double reverse = 1.0;
+        for (unsigned int i = 0; i < MAX_REVERSE_BITS; ++i) {
+            rev_lst[i] = reverse;
+            reverse /= double(radix);
+        }
+        return rev_lst;
+    }
+
+    /**
+     * @brief Batch kernel: `out[j] = chunk_lst[j] + terms[0] + terms[1] + ...`
+     *
+     * The sums are evaluated left to right, lane by lane: the lowest-digit
+     * contribution of each value first, then the unchanged contributions of
+     * the higher digits, least significant first. Uses AVX-512F, AVX2 or
+     * plain scalar code, whichever the CPU supports (selected once, at the
+     * first call). All variants round identically. Defined in vdc_kernel.cpp.
+     *
+     * No digits are extracted in the vector lanes, by multiply-high or
+     * otherwise: `VdcOdometer` carries the digits above the lowest chunk
+     * from one run to the next, and the lowest chunk is read from a table
+     * (here) or is a ramp (`vdc_ramp()`), so what remains per value is this
+     * sum. Extracting every digit of every lane would cost a multiply-high,
+     * a multiply and a subtract per digit where this costs one add.
+     *
+     * @param[in] chunk_lst the lowest-digit contributions, `out.size()` long
+     * @param[in] terms the contributions of the digits above the lowest one
+     * @param[out] out the buffer to fill
+     */
+    extern auto vdc_run(const double* chunk_lst, std::span<const double> terms,
+                        std::span<double> out) -> void;
+
+    /**
+     * @brief Batch kernel: `out[j] = weight * (first + j) + terms[0] + terms[1] + ...`
+     *
+     * Runtime-selected and evaluated left to right like `vdc_run()`.
+     *
+     * @param[in] weight the weight of the lowest digit
+     * @param[in] first the lowest digit of the first value
+     * @param[in] terms the contributions of the digits above the lowest one
+     * @param[out] out the buffer to fill
+     */
+    extern auto vdc_ramp(double weight, unsigned long first, std::span<const double> terms,
+                         std::span<double> out) -> void;
+
+    /**
+     * @brief Name of the batch kernel selected for this CPU
+     *
+     * @return const char* "avx512f", "avx2" or "scalar"
+     */
+    extern auto vdc_kernel_name() -> const char*;
+
+    /**
+     * @brief (cos, sin) of `2 * pi * turns`
+     *
+     * Subtracts the nearest quarter turn (exactly), so the polynomials only
+     * see an angle in [-pi/4, pi/4]: fdlibm's minimax approximations of sin
+     * and cos, within 1 ulp there. Including the rounding of the reduced
+     * angle, the result is within 2 ulp of the exact value for any `turns`
+     * below 2^50, which `std::cos(turns * TWO_PI)` is not: there the angle
+     * itself is rounded, by up to 4.4e-16. Defined in sincos_kernel.cpp.
+     *
+     * @param[in] turns the angle in full turns
+     * @return std::array<double, 2>
+     */
+    extern auto sincos_turns(double turns) -> std::array<double, 2>;
+
+    /**
+     * @brief Batch kernel: `out[j] = sincos_turns(turns[j])`
+     *
+     * Evaluates 8 (AVX-512F) or 4 (AVX2) angles per instruction, selected
+     * at runtime like `vdc_run()`. All variants round exactly like
+     * `sincos_turns()`.
+     *
+     * @param[in] turns the angles in full turns
+     * @param[out] out the (cos, sin) pairs, `turns.size()` long
+     */
+    extern auto sincos_run(std::span<const double> turns, std::span<std::array<double, 2>> out)
+        -> void;
+
+    /**
+     * @brief Batch kernel: `out[j] = std::sqrt(in[j])`
+     *
+     * Runtime-selected like `sincos_run()`. The vector square root is
+     * correctly rounded, so the results equal `std::sqrt()`. `in` and `out`
+     * may be the same buffer.
+     *
+     * @param[in] in the radicands
+     * @param[out] out the square roots, `in.size()` long
+     */
+    extern auto sqrt_run(std::span<const double> in, std::span<double> out) -> void;
+
+    /**
+     * @brief Name of the sincos/sqrt kernel selected for this CPU
+     *
+     * @return const char* "avx512f", "avx2" or "scalar"
+     */
+    extern auto sincos_kernel_name() -> const char*;
+
+    /**
+     * @brief Incremental ("odometer") Van der Corput engine
+     *
+     * Keeps the base-b digits of the current count together with their
+     * contributions `rev_lst[i] * digit`. Advancing increments the lowest
+     * digit and only carries while digits wrap, so no step divides. The value
+     * is then the sum of the contributions, least significant first, which
+     * is the order `VdCorput::at()` (and the original digit loop of `pop()`)
+     * adds them in, so the output is bit-identical to it. Small bases keep
+     * their lowest k digits as one chunk and take its contribution from
+     * `chunk_table()`, so that a step adds one term per digit above it.
+     *
+     * Base 2 skips the digit bookkeeping and uses `vdc_base2()` on a plain
+     * counter instead, which is cheaper still.
+     *
+     * An odometer is plain (non-atomic) state meant to be owned by one thread,
+     * e.g. for the duration of a batch fill. Its members are defined in
+     * vdc_kernel.cpp, which is compiled without FP contraction, so that code
+     * built with FMA enabled cannot round them differently from `at()`.
+     *
+     * @verbatim
+     *     VdcOdometer(2, rev_lst, 0):
+     *     pop() -> 0.5   (digits 1)
+     *     pop() -> 0.25  (digits 01, one carry)
+     *     pop() -> 0.75  (digits 11)
+     *     ...
+     * @endverbatim
+     */
+    class VdcOdometer {
+        unsigned long base;
+        const std::array<double, MAX_REVERSE_BITS>* rev_lst;
+        std::span<const double> chunk_lst;
+        /// radix of the lowest chunk: b^k with a chunk table, b without
+        unsigned long radix;
+        /// number of digits in the lowest chunk
+        unsigned int low_digits;
+        unsigned long count;
+        unsigned long low{0};
+        unsigned int num_digits{0};
+        /// the digits above the lowest chunk
+        std::array<unsigned long, MAX_REVERSE_BITS> digits{};
+        /// terms[i] = rev_lst[low_digits + i] * digits[i]
+        std::array<double, MAX_REVERSE_BITS> terms{};
+
+      public:
+        /**
+         * @brief Construct a new VdcOdometer object
+         *
+         * @param[in] base the base of the Van der Corput sequence
+         * @param[in] rev_lst the weights of the digits, `reciprocal_powers(base)`
+         * @param[in] index the index the first `pop()` corresponds to
+         * @param[in] chunk_lst the digit-chunk table of the base, or empty
+         */
+        VdcOdometer(unsigned long base, const std::array<double, MAX_REVERSE_BITS>& rev_lst,
+                    unsigned long index, std::span<const double> chunk_lst = {});
+
+        /**
+         * @brief Advance to the next count and return its value
+         *
+         * @return double the next value in the sequence
+         */
+        auto pop() -> double;
+
+        /**
+         * @brief Write the next `out.size()` values
+         *
+         * Equivalent to calling `pop()` for each element, but splits the
+         * output into runs over which only the lowest chunk (or digit)
+         * changes. A run is one vector kernel call (`vdc_run()` or
+         * `vdc_ramp()`) that adds the unchanged contributions of the higher
+         * digits to each lowest-chunk contribution; no division is needed at
+         * all. Base 2 does the same with 10-bit chunks.
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<double> out) -> void;
+
+      private:
+        auto set_digit(unsigned int i, unsigned long digit) -> void;
+        auto carry() -> void;
+    };
+
+    /**
+     * @brief Van der Corput value from a table of reciprocal powers
+     *
+     * Accumulates the digit contributions `rev_lst[i] * digit` least
+     * significant first, exactly like the original digit loop of
+     * `VdCorput::pop()`, and like `VdcOdometer`, so the three agree bit for
+     * bit. Base 2 is better served by `vdc_base2()`; the engines dispatch it.
+     *
+     * To continue a sum, e.g. after the lowest chunk of digits has been
+     * looked up in `chunk_table()`, pass the partial sum and the position of
+     * the next digit.
+     *
+     * @tparam Base a `std::integral_constant`, so that the compiler can lower
+     *              `%` and `/` to multiply-shift sequences, or a `FastDivider`,
+     *              which does the same for a runtime base
+     * @param[in] count index of the sequence (or what is left of it)
+     * @param[in] base base of the sequence
+     * @param[in] rev_lst the weights of the digits, `reciprocal_powers(base)`
+     * @param[in] position the position of the lowest digit of `count`
+     * @param[in] res the sum of the contributions of the digits below it
+     * @return double
+     */
+    template <typename Base>
+    constexpr auto vdc_table(unsigned long count, const Base& base,
+                             const std::array<double, MAX_REVERSE_BITS>& rev_lst,
+                             unsigned int position = 0, double res = 0.0) -> double {
+        for (; count != 0; ++position) {
+            const auto digit = static_cast<unsigned long>(count % base);
+            count = static_cast<unsigned long>(count / base);
+            res += rev_lst[position] * double(digit);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Van der Corput value from a table of reciprocal powers, at run time
+     *
+     * `vdc_table()` with a `FastDivider`, compiled into the library without
+     * FP contraction: every product and sum is rounded on its own, whatever
+     * flags the calling code is built with, so `at()` agrees with
+     * `VdcOdometer` and the batch kernels. Defined in vdc_kernel.cpp.
+     *
+     * @param[in] count index of the sequence (or what is left of it)
+     * @param[in] base base of the sequence
+     * @param[in] rev_lst the weights of the digits, `reciprocal_powers(base)`
+     * @param[in] position the position of the lowest digit of `count`
+     * @param[in] res the sum of the contributions of the digits below it
+     * @return double
+     */
+    extern auto vdc_digits(unsigned long count, const FastDivider& base,
+                           const std::array<double, MAX_REVERSE_BITS>& rev_lst,
+                           unsigned int position = 0, double res = 0.0) -> double;
+
+    /**
+     * @brief Radical inverse engine with a runtime base
+     *
+     * Stateless part of a Van der Corput generator: it maps an index to its
+     * value, but does not keep a count. `BasicVdCorput` pairs it with one.
+     * The digit loop divides through a `FastDivider` built once per base,
+     * which avoids a hardware `div` per digit, and bases up to
+     * `MAX_CHUNK_BASE` take their lowest k digits in one step from a shared
+     * `chunk_table()`. The digits are accumulated least significant first,
+     * so the values are those of the original digit loop, bit for bit.
+     */
+    class RadicalInverse {
+        unsigned long base;
+        std::span<const double> chunk_lst;
+        unsigned long radix;
+        unsigned int low_digits;
+        FastDivider chunk_divider;
+        FastDivider divider;
+        std::array<double, MAX_REVERSE_BITS> rev_lst;
+
+      public:
+        /**
+         * @brief Construct a new RadicalInverse object
+         *
+         * @param[in] base the base of the Van der Corput sequence
+         */
+        explicit RadicalInverse(const unsigned long base)
+            : base{base},
+              chunk_lst{chunk_table(base), has_chunk_table(base) ? chunk_radix(base) : 0},
+              radix{has_chunk_table(base) ? chunk_radix(base) : base},
+              low_digits{has_chunk_table(base) ? chunk_digits(base) : 1},
+              chunk_divider{this->radix},
+              divider{base},
+              rev_lst{reciprocal_powers(base)} {}
+
+        /**
+         * @brief Get the value at a given index
+         *
+         * @param[in] index the index in the sequence (index 0 maps to count 1)
+         * @return double
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> double {
+            if (this->base == 2) {
+                return vdc_base2(index + 1);
+            }
+            if (this->chunk_lst.empty()) {
+                return vdc_digits(index + 1, this->divider, this->rev_lst);
+            }
+            const auto high = (index + 1) / this->chunk_divider;
+            return vdc_digits(high, this->divider, this->rev_lst, this->low_digits,
+                              this->chunk_lst[index + 1 - high * this->radix]);
+        }
+
+        /**
+         * @brief Create an incremental engine positioned at a given index
+         *
+         * @param[in] index the index in the sequence
+         * @return VdcOdometer
+         */
+        [[nodiscard]] auto odometer(unsigned long index) const -> VdcOdometer {
+            return VdcOdometer(this->base, this->rev_lst, index, this->chunk_lst);
+        }
+
+        /**
+         * @brief Get the base
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] auto get_base() const -> unsigned long { return this->base; }
+    };
+
+    /**
+     * @brief Radical inverse engine with a compile-time base
+     *
+     * Same interface as `RadicalInverse`, but the reciprocal powers and the
+     * divider are computed at compile time, the split of the lowest chunk
+     * divides by a constant, and `at()` is usable in constant expressions.
+     *
+     * @tparam Base the base of the Van der Corput sequence
+     */
+    template <unsigned long Base> class RadicalInverseT {
+        static_assert(Base >= 2, "Base must be at least 2");
+
+        static constexpr std::span<const double> chunk_lst{
+            chunk_table(Base), has_chunk_table(Base) ? chunk_radix(Base) : 0};
+        static constexpr std::array<double, MAX_REVERSE_BITS> rev_lst = reciprocal_powers(Base);
+        static constexpr unsigned long radix = has_chunk_table(Base) ? chunk_radix(Base) : Base;
+        static constexpr unsigned int low_digits = has_chunk_table(Base) ? chunk_digits(Base) : 0;
+        static constexpr FastDivider divider{Base};
+
+      public:
+        /**
+         * @brief Get the value at a given index
+         *
+         * Evaluated at compile time in a constant expression; at run time
+         * the digits above the lowest chunk go through `vdc_digits()`.
+         *
+         * @param[in] index the index in the sequence (index 0 maps to count 1)
+         * @return double
+         */
+        [[nodiscard]] constexpr auto at(unsigned long index) const -> double {
+            if constexpr (Base == 2) {
+                return vdc_base2(index + 1);
+            } else {
+                const auto high = has_chunk_table(Base) ? (index + 1) / radix : index + 1;
+                const auto low = has_chunk_table(Base) ? chunk_lst[(index + 1) % radix] : 0.0;
+                if (std::is_constant_evaluated()) {
+                    return vdc_table(high, std::integral_constant<unsigned long, Base>{}, rev_lst,
+                                     low_digits, low);
+                }
+                return vdc_digits(high, divider, rev_lst, low_digits, low);
+            }
+        }
+
+        /**
+         * @brief Create an incremental engine positioned at a given index
+         *
+         * @param[in] index the index in the sequence
+         * @return VdcOdometer
+         */
+        [[nodiscard]] auto odometer(unsigned long index) const -> VdcOdometer {
+            return VdcOdometer(Base, rev_lst, index, chunk_lst);
+        }
+
+        /**
+         * @brief Get the base
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] constexpr auto get_base() const -> unsigned long { return Base; }
+    };
+
+    /**
+     * @brief Product of two points of the unit circle as complex numbers
+     *
+     * @param[in] lhs (cos a, sin a)
+     * @param[in] rhs (cos b, sin b)
+     * @return std::array<double, 2> (cos(a + b), sin(a + b))
+     *
+     * The real part adds `(-sin a) * sin b` rather than subtracting `sin a * sin b`
+     * (the same value): GCC 12 turns the mixed subtract/add of a complex product
+     * into `vfmaddsub` even under `-ffp-contract=off`, which would round the
+     * batch paths differently from the scalar ones.
+     */
+    constexpr auto unit_mul(const std::array<double, 2>& lhs, const std::array<double, 2>& rhs)
+        -> std::array<double, 2> {
+        return {lhs[0] * rhs[0] + (-lhs[1]) * rhs[1], lhs[0] * rhs[1] + lhs[1] * rhs[0]};
+    }
+
+    /**
+     * @brief Radical inverse engine that also maps an index onto the unit circle
+     *
+     * Besides `at()` and `odometer()`, such an engine (`UnitRoots`, see
+     * unit_roots.hpp) computes (cos, sin) of `2 * pi * at(index)` without
+     * trigonometric calls, for a single index (`unit_at()`) or incrementally
+     * (`unit_odometer()`, whose `fill()` writes a span of such points). The
+     * circle-based generators use it instead of `std::cos` and `std::sin`.
+     */
+    template <typename Engine> concept UnitRootEngine
+        = requires(const Engine& engine, unsigned long index,
+                   std::span<std::array<double, 2>> out) {
+              { engine.unit_at(index) } -> std::same_as<std::array<double, 2>>;
+              engine.unit_odometer(index).fill(out);
+          };
+
+    /**
+     * @brief Thread-safe counter policy
+     *
+     * Every operation is a single relaxed atomic operation, so one generator
+     * can be shared by several threads, each of them getting distinct
+     * indices. The counter fills a cache line of its own, so that updating it
+     * does not evict the (read-only) bases that every thread reads.
+     */
+    class AtomicCounter {
+        alignas(CACHE_LINE_SIZE) std::atomic<unsigned long> value{0};
+
+      public:
+        AtomicCounter() = default;
+
+        /**
+         * @brief Copy a snapshot of the counter
+         *
+         * Copies and assignments read the other counter once, so generators
+         * holding one are copyable and movable values. Updates made to the
+         * source while it is being copied may or may not be seen.
+         *
+         * @param[in] other the counter to copy
+         */
+        AtomicCounter(const AtomicCounter& other) noexcept : value{other.load()} {}
+
+        auto operator=(const AtomicCounter& other) noexcept -> AtomicCounter& {
+            this->store(other.load());
+            return *this;
+        }
+
+        /**
+         * @brief Add to the counter
+         *
+         * @param[in] n the increment
+         * @return unsigned long the value before the addition
+         */
+        auto fetch_add(unsigned long n) -> unsigned long {
+            return this->value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the value of the counter
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] auto load() const -> unsigned long {
+            return this->value.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Set the value of the counter
+         *
+         * @param[in] n the new value
+         */
+        auto store(unsigned long n) -> void { this->value.store(n, std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Single-threaded counter policy
+     *
+     * Same interface as `AtomicCounter`, but a plain integer: no locked
+     * read-modify-write, and the compiler may keep it in a register and
+     * vectorize loops over `pop()`. A generator using it must be owned by one
+     * thread.
+     */
+    class LocalCounter {
+        unsigned long value{0};
+
+      public:
+        /**
+         * @brief Add to the counter
+         *
+         * @param[in] n the increment
+         * @return unsigned long the value before the addition
+         */
+        auto fetch_add(unsigned long n) -> unsigned long {
+            const auto old = this->value;
+            this->value += n;
+            return old;
+        }
+
+        /**
+         * @brief Get the value of the counter
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] auto load() const -> unsigned long { return this->value; }
+
+        /**
+         * @brief Set the value of the counter
+         *
+         * @param[in] n the new value
+         */
+        auto store(unsigned long n) -> void { this->value = n; }
+    };
+
     /**
      * @brief Van der Corput sequence generator
      *
@@ -150,6 +913,17 @@ namespace ldsgen {
      * `VdCorput` class keeps track of the current count and base, and provides a
      * `pop()` method that returns the next value in the sequence.
      *
+     * `BasicVdCorput` is parameterized by its radical inverse engine: `VdCorput`
+     * takes the base at runtime, `VdCorputT<Base>` at compile time. The counter
+     * policy makes it thread-safe (`AtomicCounter`, the default) or not
+     * (`LocalCounter`, as in `LocalVdCorput`).
+     *
+     * The value type is `double` by default. With `float` (`VdCorputF`) the
+     * radical inverse is still computed in double and rounded once, so each
+     * value is within half a float ulp of the exact one (at most 2^-25 in
+     * [0.5, 1)). A sum of float digit weights would round once per digit and
+     * be no faster: the digit extraction is integer work.
+     *
      * @verbatim
      *     VdCorput(2) sequence:
      *     pop() -> 0.5   (0.1 base 2)
@@ -158,11 +932,17 @@ namespace ldsgen {
      *     pop() -> 0.125 (0.001 base 2)
      *     ...
      * @endverbatim
+     *
+     * @tparam Engine `RadicalInverse` or `RadicalInverseT<Base>`
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the value type
      */
-    class VdCorput {
-        std::atomic<unsigned long> count;
-        unsigned long base;
-        std::array<double, MAX_REVERSE_BITS> rev_lst;
+    template <typename Engine, typename Counter = AtomicCounter, typename Real = double>
+    class BasicVdCorput {
+        static_assert(std::is_floating_point_v<Real>, "Real must be float or double");
+
+        Counter count;
+        Engine engine;
         static_assert(MAX_REVERSE_BITS >= sizeof(unsigned long) * 8,
                       "MAX_REVERSE_BITS must be at least the number of bits in unsigned long");
 
@@ -176,13 +956,14 @@ namespace ldsgen {
          *
          * @param[in] base the base of the Van der Corput sequence
          */
-        explicit VdCorput(const unsigned long base) : count{0}, base{base}, rev_lst{} {
-            double reverse = 1.0;
-            for (unsigned int i = 0; i < MAX_REVERSE_BITS; ++i) {
-                reverse /= double(base);
-                this->rev_lst[i] = reverse;
-            }
-        }
+        explicit BasicVdCorput(const unsigned long base) : count{}, engine{base} {}
+
+        /**
+         * @brief Construct a new VdCorputT object (compile-time base)
+         */
+        BasicVdCorput()
+            requires std::is_default_constructible_v<Engine>
+            : count{}, engine{} {}
 
         /**
          * @brief Generate the next value in the Van der Corput sequence
@@ -191,38 +972,43 @@ namespace ldsgen {
          * the count and calculating the Van der Corput sequence value for that count
          * and base.
          *
-         * @return double the next value in the sequence
+         * @return Real the next value in the sequence
          */
-        auto pop() -> double {
-            unsigned long count_value
-                = this->count.fetch_add(1, std::memory_order_relaxed) + 1;  // ignore 0
-            unsigned long idx = 0;
-            double res = 0.0;
-            while (count_value != 0) {
-                const auto remainder = count_value % this->base;
-                count_value /= this->base;
-                res += this->rev_lst[idx] * double(remainder);
-                ++idx;
-            }
-            return res;
+        auto pop() -> Real {
+            return this->at(this->count.fetch_add(1));
         }
 
         /**
          * @brief Peek at the next value without advancing state
          *
-         * @return double the next value in the sequence
+         * @return Real the next value in the sequence
          */
-        [[nodiscard]] auto peek() -> double {
-            unsigned long count_value = this->count.load(std::memory_order_relaxed) + 1;
-            unsigned long idx = 0;
-            double res = 0.0;
-            while (count_value != 0) {
-                const auto remainder = count_value % this->base;
-                count_value /= this->base;
-                res += this->rev_lst[idx] * double(remainder);
-                ++idx;
-            }
-            return res;
+        [[nodiscard]] auto peek() -> Real {
+            return this->at(this->count.load());
+        }
+
+        /**
+         * @brief Get the value at a given index without advancing state
+         *
+         * Returns the value that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Real the value at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Real {
+            return static_cast<Real>(this->engine.at(index));
+        }
+
+        /**
+         * @brief Create an incremental engine positioned at a given index
+         *
+         * The first `pop()` of the returned odometer yields `at(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return VdcOdometer
+         */
+        [[nodiscard]] auto odometer(unsigned long index) const -> VdcOdometer {
+            return this->engine.odometer(index);
         }
 
         /**
@@ -230,7 +1016,51 @@ namespace ldsgen {
          *
          * @param[in] n number of values to skip
          */
-        auto skip(unsigned int n) -> void { this->count.fetch_add(n, std::memory_order_relaxed); }
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next values in the sequence
+         *
+         * Claims `out.size()` consecutive indices at once and writes the values
+         * straight into `out`, which is equivalent to (but much cheaper than)
+         * calling `pop()` `out.size()` times.
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<Real> out) -> void { this->fill(this->claim(out.size()), out); }
+
+        /**
+         * @brief Fill a buffer with the values starting at a given index
+         *
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first value
+         * @param[out] out the buffer to fill
+         */
+        auto fill(unsigned long start, std::span<Real> out) const -> void {
+            if constexpr (std::is_same_v<Real, double>) {
+                this->odometer(start).fill(out);
+            } else {
+                auto odo = this->odometer(start);
+                std::array<double, FILL_BLOCK> block;
+                while (!out.empty()) {
+                    const auto num = std::min(out.size(), FILL_BLOCK);
+                    odo.fill(std::span(block).first(num));
+                    std::copy_n(block.begin(), num, out.begin());
+                    out = out.subspan(num);
+                }
+            }
+        }
 
         /**
          * @brief reseed
@@ -243,7 +1073,23 @@ namespace ldsgen {
          * @param[in] seed the seed value to reset the sequence generator to
          */
         auto reseed(const unsigned long& seed) -> void {
-            this->count.store(seed, std::memory_order_relaxed);
+            this->count.store(seed);
+        }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * The copy has its own counter, so each thread can pop from a fork
+         * of a prototype without sharing a cache line with the others. Use
+         * disjoint ranges of `start` to split one sequence between them.
+         *
+         * @param[in] start the index of the first value the copy pops
+         * @return BasicVdCorput
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicVdCorput {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
 
         /**
@@ -251,17 +1097,15 @@ namespace ldsgen {
          *
          * @return unsigned long current index in the sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long {
-            return this->count.load(std::memory_order_relaxed);
-        }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<VdCorput, double>
+         * @return GeneratorIterator<BasicVdCorput, Real>
          */
-        auto begin() -> GeneratorIterator<VdCorput, double> {
-            return GeneratorIterator<VdCorput, double>(this);
+        [[nodiscard]] auto begin() const -> GeneratorIterator<BasicVdCorput, Real> {
+            return GeneratorIterator<BasicVdCorput, Real>(this);
         }
 
         /**
@@ -269,17 +1113,31 @@ namespace ldsgen {
          *
          * For infinite sequences, you typically use begin() + n to get a specific position
          *
-         * @return GeneratorIterator<VdCorput, double>
+         * @return GeneratorIterator<BasicVdCorput, Real>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<VdCorput, double> {
-            return GeneratorIterator<VdCorput, double>(nullptr,
-                                                       std::numeric_limits<unsigned long>::max());
+        [[nodiscard]] auto end() const -> GeneratorIterator<BasicVdCorput, Real> {
+            return GeneratorIterator<BasicVdCorput, Real>(
+                nullptr, std::numeric_limits<unsigned long>::max());
         }
 
-        VdCorput(VdCorput&&) noexcept = delete;
-        VdCorput& operator=(VdCorput&&) noexcept = delete;
     };
 
+    /// Van der Corput sequence generator with a runtime base
+    using VdCorput = BasicVdCorput<RadicalInverse>;
+
+    /// Van der Corput sequence generator with a compile-time base
+    template <unsigned long Base> using VdCorputT = BasicVdCorput<RadicalInverseT<Base>>;
+
+    /// Single-threaded Van der Corput sequence generator with a runtime base
+    using LocalVdCorput = BasicVdCorput<RadicalInverse, LocalCounter>;
+
+    /// Single-threaded Van der Corput sequence generator with a compile-time base
+    template <unsigned long Base>
+    using LocalVdCorputT = BasicVdCorput<RadicalInverseT<Base>, LocalCounter>;
+
+    /// Van der Corput sequence generator with a runtime base and float values
+    using VdCorputF = BasicVdCorput<RadicalInverse, AtomicCounter, float>;
+
     /**
      * @brief Halton sequence generator
      *
@@ -298,10 +1156,26 @@ namespace ldsgen {
      *     pop() -> (0.75, 0.111) (VdC(2) -> 0.75, VdC(3) -> 0.111)
      *     ...
      * @endverbatim
+     *
+     * Both coordinates are computed from one index, claimed from a single
+     * counter, so concurrent callers always get whole points of the sequence.
+     *
+     * Like `BasicVdCorput`, a `float` generator (`HaltonF`) rounds each
+     * coordinate once from double.
+     *
+     * @tparam Engine0 radical inverse engine of the first dimension
+     * @tparam Engine1 radical inverse engine of the second dimension
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the coordinate type
      */
-    class Halton {
-        VdCorput vdc0;
-        VdCorput vdc1;
+    template <typename Engine0, typename Engine1 = Engine0, typename Counter = AtomicCounter,
+              typename Real = double>
+    class BasicHalton {
+        using Point = std::array<Real, 2>;
+
+        Counter count;
+        Engine0 vdc0;
+        Engine1 vdc1;
 
       public:
         /**
@@ -313,26 +1187,32 @@ namespace ldsgen {
          * @param[in] base0 the base for the first dimension
          * @param[in] base1 the base for the second dimension
          */
-        Halton(const unsigned long base0, const unsigned long base1) : vdc0(base0), vdc1(base1) {}
+        BasicHalton(const unsigned long base0, const unsigned long base1)
+            : count{}, vdc0(base0), vdc1(base1) {}
+
+        /**
+         * @brief Construct a new HaltonT object (compile-time bases)
+         */
+        BasicHalton() = default;
 
         /**
          * @brief Generate the next point in the Halton sequence
          *
          * Returns the next point in the Halton sequence as an array of two double values.
          *
-         * @return std::array<double, 2> the next point in the sequence
+         * @return Point the next point in the sequence
          */
-        auto pop() -> std::array<double, 2> {  //
-            return {this->vdc0.pop(), this->vdc1.pop()};
+        auto pop() -> Point {  //
+            return this->at(this->count.fetch_add(1));
         }
 
         /**
          * @brief Peek at the next value without advancing state
          *
-         * @return std::array<double, 2> the next point in the sequence
+         * @return Point the next point in the sequence
          */
-        [[nodiscard]] auto peek() -> std::array<double, 2> {
-            return {this->vdc0.peek(), this->vdc1.peek()};
+        [[nodiscard]] auto peek() -> Point {
+            return this->at(this->count.load());
         }
 
         /**
@@ -340,9 +1220,62 @@ namespace ldsgen {
          *
          * @param[in] n number of values to skip
          */
-        auto skip(unsigned int n) -> void {
-            this->vdc0.skip(n);
-            this->vdc1.skip(n);
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * Returns the point that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            return {static_cast<Real>(this->vdc0.at(index)),
+                    static_cast<Real>(this->vdc1.at(index))};
+        }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<Point> out) -> void {
+            this->fill(this->claim(out.size()), out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         */
+        auto fill(unsigned long start, std::span<Point> out) const -> void {
+            auto odo0 = this->vdc0.odometer(start);
+            auto odo1 = this->vdc1.odometer(start);
+            std::array<double, FILL_BLOCK> block0;
+            std::array<double, FILL_BLOCK> block1;
+            while (!out.empty()) {
+                const auto num = std::min(out.size(), FILL_BLOCK);
+                odo0.fill(std::span(block0).first(num));
+                odo1.fill(std::span(block1).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[i] = {static_cast<Real>(block0[i]), static_cast<Real>(block1[i])};
+                }
+                out = out.subspan(num);
+            }
         }
 
         /**
@@ -352,9 +1285,20 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(const unsigned long& seed) -> void {
-            this->vdc0.reseed(seed);
-            this->vdc1.reseed(seed);
+        auto reseed(const unsigned long& seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return BasicHalton
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicHalton {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
 
         /**
@@ -362,28 +1306,41 @@ namespace ldsgen {
          *
          * @return unsigned long current index in the sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long { return this->vdc0.get_index(); }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<Halton, std::array<double, 2>>
+         * @return GeneratorIterator<BasicHalton, Point>
          */
-        auto begin() -> GeneratorIterator<Halton, std::array<double, 2>> {
-            return GeneratorIterator<Halton, std::array<double, 2>>(this);
+        [[nodiscard]] auto begin() const -> GeneratorIterator<BasicHalton, Point> {
+            return GeneratorIterator<BasicHalton, Point>(this);
         }
 
         /**
          * @brief Get iterator to end (infinite sequence)
          *
-         * @return GeneratorIterator<Halton, std::array<double, 2>>
+         * @return GeneratorIterator<BasicHalton, Point>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<Halton, std::array<double, 2>> {
-            return GeneratorIterator<Halton, std::array<double, 2>>(
+        [[nodiscard]] auto end() const -> GeneratorIterator<BasicHalton, Point> {
+            return GeneratorIterator<BasicHalton, Point>(
                 nullptr, std::numeric_limits<unsigned long>::max());
         }
     };
 
+    /// Halton sequence generator with runtime bases
+    using Halton = BasicHalton<RadicalInverse>;
+
+    /// Single-threaded Halton sequence generator with runtime bases
+    using LocalHalton = BasicHalton<RadicalInverse, RadicalInverse, LocalCounter>;
+
+    /// Halton sequence generator with compile-time bases
+    template <unsigned long Base0, unsigned long Base1>
+    using HaltonT = BasicHalton<RadicalInverseT<Base0>, RadicalInverseT<Base1>>;
+
+    /// Halton sequence generator with runtime bases and float coordinates
+    using HaltonF = BasicHalton<RadicalInverse, RadicalInverse, AtomicCounter, float>;
+
     /**
      * @brief Circle sequence generator
      *
@@ -407,49 +1364,202 @@ namespace ldsgen {
      *     Points distributed more evenly
      *     than random sampling
      * @endverbatim
+     *
+     * With `double` coordinates, (cos, sin) comes from `sincos_turns()`, and
+     * `fill()` evaluates a block of angles at a time with the vector kernel
+     * `sincos_run()`; both round identically. This applies to the
+     * single-point `pop()` and `at()` too, which used to return `std::cos`
+     * and `std::sin` of `vdc * TWO_PI`: the points of `Circle`, `Disk` and
+     * `Sphere` differ from those by up to 1e-15 per coordinate, those of
+     * `Sphere3Hopf` by up to 4e-15, and are the more accurate ones (see
+     * `sincos_turns()`). With `float` coordinates (`CircleF`) the angle is
+     * computed in double and rounded once, and `std::cos`/`std::sin` run in
+     * float (`cosf`, `sinf`). Each coordinate is then within 1e-6 of the
+     * double generator's; the same bound holds for `DiskF`, `SphereF` and
+     * `Sphere3HopfF`.
+     *
+     * @tparam Engine radical inverse engine
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the coordinate type
      */
-    class Circle {
-        VdCorput vdc;
+    template <typename Engine, typename Counter = AtomicCounter, typename Real = double>
+    class BasicCircle {
+        template <typename, typename, typename, typename> friend class BasicDisk;
+        template <typename, typename, typename, typename> friend class BasicSphere;
+
+        using Point = std::array<Real, 2>;
+
+        Counter count;
+        Engine vdc;
+
+        static auto map_point(double vdc_value) -> Point {
+            if constexpr (std::is_same_v<Real, double>) {
+                return sincos_turns(vdc_value);
+            } else {
+                auto theta = static_cast<Real>(vdc_value * TWO_PI);  // map to [0, 2*pi];
+                return {std::cos(theta), std::sin(theta)};
+            }
+        }
+
+        // (cos, sin) of 2 * pi * engine.at(index), without trigonometry for a UnitRootEngine
+        static auto unit_at(const Engine& engine, unsigned long index) -> Point {
+            if constexpr (UnitRootEngine<Engine>) {
+                const auto unit = engine.unit_at(index);
+                return {static_cast<Real>(unit[0]), static_cast<Real>(unit[1])};
+            } else {
+                return map_point(engine.at(index));
+            }
+        }
+
+        // unit_at() of the indices start, start + 1, ..., start + out.size() - 1
+        static auto unit_fill(const Engine& engine, unsigned long start, std::span<Point> out)
+            -> void {
+            if constexpr (UnitRootEngine<Engine> && std::is_same_v<Real, double>) {
+                engine.unit_odometer(start).fill(out);
+            } else if constexpr (UnitRootEngine<Engine>) {
+                auto odo = engine.unit_odometer(start);
+                std::array<std::array<double, 2>, FILL_BLOCK> block;
+                while (!out.empty()) {
+                    const auto num = std::min(out.size(), FILL_BLOCK);
+                    odo.fill(std::span(block).first(num));
+                    for (std::size_t i = 0; i < num; ++i) {
+                        out[i] = {static_cast<Real>(block[i][0]), static_cast<Real>(block[i][1])};
+                    }
+                    out = out.subspan(num);
+                }
+            } else {
+                auto odo = engine.odometer(start);
+                std::array<double, FILL_BLOCK> block;
+                while (!out.empty()) {
+                    const auto num = std::min(out.size(), FILL_BLOCK);
+                    odo.fill(std::span(block).first(num));
+                    if constexpr (std::is_same_v<Real, double>) {
+                        sincos_run(std::span(block).first(num), out.first(num));
+                    } else {
+                        for (std::size_t i = 0; i < num; ++i) {
+                            out[i] = map_point(block[i]);
+                        }
+                    }
+                    out = out.subspan(num);
+                }
+            }
+        }
+
+      public:
+        /**
+         * @brief Construct a new Circle object
+         *
+         * Constructs a Circle sequence generator with the specified base for generating
+         * the Van der Corput sequence, which is then mapped to points on the unit circle.
+         *
+         * @param[in] base the base for the Van der Corput sequence generator
+         */
+        explicit BasicCircle(const unsigned long base) : count{}, vdc(base) {}
+
+        /**
+         * @brief Construct a new CircleT object (compile-time base)
+         */
+        BasicCircle() = default;
+
+        /**
+         * @brief Generate the next point on the unit circle
+         *
+         * Returns the next point on the unit circle as an array of two double values.
+         *
+         * @return Point the next point on the unit circle
+         */
+        auto pop() -> Point { return this->at(this->count.fetch_add(1)); }
+
+        /**
+         * @brief Peek at the next value without advancing state
+         *
+         * @return Point next point on the circle
+         */
+        [[nodiscard]] auto peek() -> Point {
+            return this->at(this->count.load());
+        }
 
-      public:
         /**
-         * @brief Construct a new Circle object
+         * @brief Skip n values in the sequence
          *
-         * Constructs a Circle sequence generator with the specified base for generating
-         * the Van der Corput sequence, which is then mapped to points on the unit circle.
+         * @param[in] n number of values to skip
+         */
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
          *
-         * @param[in] base the base for the Van der Corput sequence generator
+         * Returns the point that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
          */
-        explicit Circle(const unsigned long base) : vdc(base) {}
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            return unit_at(this->vdc, index);
+        }
 
         /**
-         * @brief Generate the next point on the unit circle
+         * @brief Claim a range of indices with a single atomic operation
          *
-         * Returns the next point on the unit circle as an array of two double values.
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
          *
-         * @return std::array<double, 2> the next point on the unit circle
+         * @param[out] out the buffer to fill
          */
-        auto pop() -> std::array<double, 2> {
-            auto theta = this->vdc.pop() * TWO_PI;  // map to [0, 2*pi];
-            return {std::cos(theta), std::sin(theta)};
+        auto fill(std::span<Point> out) -> void {
+            this->fill(this->claim(out.size()), out);
         }
 
         /**
-         * @brief Peek at the next value without advancing state
+         * @brief Fill a buffer with the points starting at a given index
          *
-         * @return std::array<double, 2> next point on the circle
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
          */
-        [[nodiscard]] auto peek() -> std::array<double, 2> {
-            auto theta = this->vdc.peek() * TWO_PI;  // map to [0, 2*pi];
-            return {std::cos(theta), std::sin(theta)};
+        auto fill(unsigned long start, std::span<Point> out) const -> void {
+            unit_fill(this->vdc, start, out);
         }
 
         /**
-         * @brief Skip n values in the sequence
+         * @brief Fill coordinate arrays with the next points in the sequence
          *
-         * @param[in] n number of values to skip
+         * @param[out] out the x and y arrays, of equal size
+         */
+        auto fill_soa(SoaSpan<2, Real> out) -> void {
+            this->fill_soa(this->claim(out[0].size()), out);
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the points starting at a given index
+         *
+         * Structure-of-arrays counterpart of `fill(start, out)` with identical
+         * values: coordinate k of point i goes to `out[k][i]`, so every array
+         * is written with unit stride. Does not advance the state of the
+         * generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the x and y arrays, of equal size
          */
-        auto skip(unsigned int n) -> void { this->vdc.skip(n); }
+        auto fill_soa(unsigned long start, SoaSpan<2, Real> out) const -> void {
+            std::array<Point, FILL_BLOCK> block;
+            for (std::size_t k = 0; k < out[0].size(); k += FILL_BLOCK) {
+                const auto num = std::min(out[0].size() - k, FILL_BLOCK);
+                unit_fill(this->vdc, start + k, std::span(block).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[0][k + i] = block[i][0];
+                    out[1][k + i] = block[i][1];
+                }
+            }
+        }
 
         /**
          * @brief Reset the state of the Circle sequence generator
@@ -458,35 +1568,61 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(const unsigned long& seed) -> void { this->vdc.reseed(seed); }
+        auto reseed(const unsigned long& seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return BasicCircle
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicCircle {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
+        }
 
         /**
          * @brief Get current index
          *
          * @return unsigned long current index in sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long { return this->vdc.get_index(); }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<Circle, std::array<double, 2>>
+         * @return GeneratorIterator<BasicCircle, Point>
          */
-        auto begin() -> GeneratorIterator<Circle, std::array<double, 2>> {
-            return GeneratorIterator<Circle, std::array<double, 2>>(this);
+        [[nodiscard]] auto begin() const -> GeneratorIterator<BasicCircle, Point> {
+            return GeneratorIterator<BasicCircle, Point>(this);
         }
 
         /**
          * @brief Get iterator to end (infinite sequence)
          *
-         * @return GeneratorIterator<Circle, std::array<double, 2>>
+         * @return GeneratorIterator<BasicCircle, Point>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<Circle, std::array<double, 2>> {
-            return GeneratorIterator<Circle, std::array<double, 2>>(
+        [[nodiscard]] auto end() const -> GeneratorIterator<BasicCircle, Point> {
+            return GeneratorIterator<BasicCircle, Point>(
                 nullptr, std::numeric_limits<unsigned long>::max());
         }
     };
 
+    /// Circle sequence generator with a runtime base
+    using Circle = BasicCircle<RadicalInverse>;
+
+    /// Single-threaded Circle sequence generator with a runtime base
+    using LocalCircle = BasicCircle<RadicalInverse, LocalCounter>;
+
+    /// Circle sequence generator with a compile-time base
+    template <unsigned long Base> using CircleT = BasicCircle<RadicalInverseT<Base>>;
+
+    /// Circle sequence generator with a runtime base and float coordinates
+    using CircleF = BasicCircle<RadicalInverse, AtomicCounter, float>;
+
     /**
      * @brief Disk sequence generator
      *
@@ -510,10 +1646,26 @@ namespace ldsgen {
      *      ***     ***
      *         *****
      * @endverbatim
+     *
+     * @tparam Engine0 radical inverse engine of the angle
+     * @tparam Engine1 radical inverse engine of the radius
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the coordinate type (see `BasicCircle`)
      */
-    class Disk {
-        VdCorput vdc0;
-        VdCorput vdc1;
+    template <typename Engine0, typename Engine1 = Engine0, typename Counter = AtomicCounter,
+              typename Real = double>
+    class BasicDisk {
+        using Point = std::array<Real, 2>;
+        using CircleMap = BasicCircle<Engine0, Counter, Real>;
+
+        Counter count;
+        Engine0 vdc0;
+        Engine1 vdc1;
+
+        static auto map_point(const Point& unit, double radius) -> Point {
+            const auto radius_r = static_cast<Real>(radius);
+            return {radius_r * unit[0], radius_r * unit[1]};
+        }
 
       public:
         /**
@@ -524,30 +1676,32 @@ namespace ldsgen {
          * @param[in] base0 the base for the first dimension (angle)
          * @param[in] base1 the base for the second dimension (radius)
          */
-        Disk(const unsigned long base0, const unsigned long base1) : vdc0(base0), vdc1(base1) {}
+        BasicDisk(const unsigned long base0, const unsigned long base1)
+            : count{}, vdc0(base0), vdc1(base1) {}
+
+        /**
+         * @brief Construct a new DiskT object (compile-time bases)
+         */
+        BasicDisk() = default;
 
         /**
          * @brief Generate the next point in the unit disk
          *
          * Returns the next point in the unit disk as an array of two double values.
          *
-         * @return std::array<double, 2> the next point in the unit disk
+         * @return Point the next point in the unit disk
          */
-        auto pop() -> std::array<double, 2> {        //
-            auto theta = this->vdc0.pop() * TWO_PI;  // map to [0, 2*pi];
-            auto radius = std::sqrt(this->vdc1.pop());
-            return {radius * std::cos(theta), radius * std::sin(theta)};
+        auto pop() -> Point {  //
+            return this->at(this->count.fetch_add(1));
         }
 
         /**
          * @brief Peek at the next value without advancing state
          *
-         * @return std::array<double, 2> next point in the disk
+         * @return Point next point in the disk
          */
-        [[nodiscard]] auto peek() -> std::array<double, 2> {
-            auto theta = this->vdc0.peek() * TWO_PI;  // map to [0, 2*pi];
-            auto radius = std::sqrt(this->vdc1.peek());
-            return {radius * std::cos(theta), radius * std::sin(theta)};
+        [[nodiscard]] auto peek() -> Point {
+            return this->at(this->count.load());
         }
 
         /**
@@ -555,9 +1709,93 @@ namespace ldsgen {
          *
          * @param[in] n number of values to skip
          */
-        auto skip(unsigned int n) -> void {
-            this->vdc0.skip(n);
-            this->vdc1.skip(n);
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * Returns the point that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            return map_point(CircleMap::unit_at(this->vdc0, index),
+                             std::sqrt(this->vdc1.at(index)));
+        }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<Point> out) -> void {
+            this->fill(this->claim(out.size()), out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         */
+        auto fill(unsigned long start, std::span<Point> out) const -> void {
+            auto odo1 = this->vdc1.odometer(start);
+            std::array<double, FILL_BLOCK> block1;
+            for (std::size_t k = 0; k < out.size(); k += FILL_BLOCK) {
+                const auto num = std::min(out.size() - k, FILL_BLOCK);
+                const auto points = out.subspan(k, num);
+                CircleMap::unit_fill(this->vdc0, start + k, points);
+                odo1.fill(std::span(block1).first(num));
+                sqrt_run(std::span(block1).first(num), std::span(block1).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    points[i] = map_point(points[i], block1[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the next points in the sequence
+         *
+         * @param[out] out the x and y arrays, of equal size
+         */
+        auto fill_soa(SoaSpan<2, Real> out) -> void {
+            this->fill_soa(this->claim(out[0].size()), out);
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the points starting at a given index
+         *
+         * Structure-of-arrays counterpart of `fill(start, out)` with identical
+         * values: coordinate k of point i goes to `out[k][i]`, so every array
+         * is written with unit stride. Does not advance the state of the
+         * generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the x and y arrays, of equal size
+         */
+        auto fill_soa(unsigned long start, SoaSpan<2, Real> out) const -> void {
+            std::array<Point, FILL_BLOCK> block;
+            for (std::size_t k = 0; k < out[0].size(); k += FILL_BLOCK) {
+                const auto num = std::min(out[0].size() - k, FILL_BLOCK);
+                this->fill(start + k, std::span(block).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[0][k + i] = block[i][0];
+                    out[1][k + i] = block[i][1];
+                }
+            }
         }
 
         /**
@@ -567,9 +1805,20 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(const unsigned long& seed) -> void {
-            this->vdc0.reseed(seed);
-            this->vdc1.reseed(seed);
+        auto reseed(const unsigned long& seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return BasicDisk
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicDisk {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
 
         /**
@@ -577,28 +1826,41 @@ namespace ldsgen {
          *
          * @return unsigned long current index in sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long { return this->vdc0.get_index(); }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<Disk, std::array<double, 2>>
+         * @return GeneratorIterator<BasicDisk, Point>
          */
-        auto begin() -> GeneratorIterator<Disk, std::array<double, 2>> {
-            return GeneratorIterator<Disk, std::array<double, 2>>(this);
+        [[nodiscard]] auto begin() const -> GeneratorIterator<BasicDisk, Point> {
+            return GeneratorIterator<BasicDisk, Point>(this);
         }
 
         /**
          * @brief Get iterator to end (infinite sequence)
          *
-         * @return GeneratorIterator<Disk, std::array<double, 2>>
+         * @return GeneratorIterator<BasicDisk, Point>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<Disk, std::array<double, 2>> {
-            return GeneratorIterator<Disk, std::array<double, 2>>(
+        [[nodiscard]] auto end() const -> GeneratorIterator<BasicDisk, Point> {
+            return GeneratorIterator<BasicDisk, Point>(
                 nullptr, std::numeric_limits<unsigned long>::max());
         }
     };
 
+    /// Disk sequence generator with runtime bases
+    using Disk = BasicDisk<RadicalInverse>;
+
+    /// Single-threaded Disk sequence generator with runtime bases
+    using LocalDisk = BasicDisk<RadicalInverse, RadicalInverse, LocalCounter>;
+
+    /// Disk sequence generator with compile-time bases
+    template <unsigned long Base0, unsigned long Base1>
+    using DiskT = BasicDisk<RadicalInverseT<Base0>, RadicalInverseT<Base1>>;
+
+    /// Disk sequence generator with runtime bases and float coordinates
+    using DiskF = BasicDisk<RadicalInverse, RadicalInverse, AtomicCounter, float>;
+
     /**
      * @brief Sphere sequence generator
      *
@@ -624,10 +1886,32 @@ namespace ldsgen {
      *       **       **
      *          *****
      * @endverbatim
+     *
+     * @tparam Engine0 radical inverse engine of the polar coordinate
+     * @tparam Engine1 radical inverse engine of the circle (azimuth)
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the coordinate type (see `BasicCircle`)
      */
-    class Sphere {
-        VdCorput vdcgen;
-        Circle cirgen;
+    template <typename Engine0, typename Engine1 = Engine0, typename Counter = AtomicCounter,
+              typename Real = double>
+    class BasicSphere {
+        using Point = std::array<Real, 3>;
+        using CircleMap = BasicCircle<Engine1, Counter, Real>;
+
+        Counter count;
+        Engine0 vdcgen;
+        Engine1 cirgen;
+
+        // the polar part stays in double: 1 - cosphi^2 cancels near the poles
+        static auto cos_polar(double vdc_value) -> double {
+            return (MAPPING_FACTOR * vdc_value) - 1.0;  // map to [-1, 1];
+        }
+
+        static auto map_point(double cosphi, double sinphi, const std::array<Real, 2>& arr)
+            -> Point {
+            const auto sinphi_r = static_cast<Real>(sinphi);
+            return {sinphi_r * arr[0], sinphi_r * arr[1], static_cast<Real>(cosphi)};
+        }
 
       public:
         /**
@@ -639,33 +1923,30 @@ namespace ldsgen {
          * @param[in] base0 the base for the Van der Corput generator (phi coordinate)
          * @param[in] base1 the base for the Circle generator (theta coordinate)
          */
-        Sphere(const unsigned long base0, const unsigned long base1)
-            : vdcgen(base0), cirgen(base1) {}
+        BasicSphere(const unsigned long base0, const unsigned long base1)
+            : count{}, vdcgen(base0), cirgen(base1) {}
+
+        /**
+         * @brief Construct a new SphereT object (compile-time bases)
+         */
+        BasicSphere() = default;
 
         /**
          * @brief Generate the next point on the unit sphere
          *
          * Returns the next point on the unit sphere as an array of three double values.
          *
-         * @return std::array<double, 3> the next point on the unit sphere
+         * @return Point the next point on the unit sphere
          */
-        auto pop() -> std::array<double, 3> {
-            auto cosphi = (MAPPING_FACTOR * this->vdcgen.pop()) - 1.0;  // map to [-1, 1];
-            auto sinphi = std::sqrt(1.0 - (cosphi * cosphi));
-            auto arr = this->cirgen.pop();
-            return {sinphi * arr[0], sinphi * arr[1], cosphi};
-        }
+        auto pop() -> Point { return this->at(this->count.fetch_add(1)); }
 
         /**
          * @brief Peek at the next value without advancing state
          *
-         * @return std::array<double, 3> next point on the sphere
+         * @return Point next point on the sphere
          */
-        [[nodiscard]] auto peek() -> std::array<double, 3> {
-            auto cosphi = (MAPPING_FACTOR * this->vdcgen.peek()) - 1.0;  // map to [-1, 1];
-            auto sinphi = std::sqrt(1.0 - (cosphi * cosphi));
-            auto arr = this->cirgen.peek();
-            return {sinphi * arr[0], sinphi * arr[1], cosphi};
+        [[nodiscard]] auto peek() -> Point {
+            return this->at(this->count.load());
         }
 
         /**
@@ -673,9 +1954,131 @@ namespace ldsgen {
          *
          * @param[in] n number of values to skip
          */
-        auto skip(unsigned int n) -> void {
-            this->vdcgen.skip(n);
-            this->cirgen.skip(n);
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * Returns the point that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            return map_at(this->vdcgen, this->cirgen, index);
+        }
+
+        /**
+         * @brief Get the point at a given index of the sphere of two engines
+         *
+         * What `at()` returns, for the generators that embed this mapping and
+         * keep the index themselves (`Sphere3`, `SphereN`, `SphereNT`).
+         *
+         * @param[in] vdcgen the engine of the polar coordinate
+         * @param[in] cirgen the engine of the circle
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] static auto map_at(const Engine0& vdcgen, const Engine1& cirgen,
+                                         unsigned long index) -> Point {
+            const auto cosphi = cos_polar(vdcgen.at(index));
+            return map_point(cosphi, std::sqrt(1.0 - (cosphi * cosphi)),
+                             CircleMap::unit_at(cirgen, index));
+        }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<Point> out) -> void {
+            this->fill(this->claim(out.size()), out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         */
+        auto fill(unsigned long start, std::span<Point> out) const -> void {
+            map_fill(this->vdcgen, this->cirgen, start, out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points of the sphere of two engines
+         *
+         * What `fill(start, out)` writes; see `map_at()`.
+         *
+         * @param[in] vdcgen the engine of the polar coordinate
+         * @param[in] cirgen the engine of the circle
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         */
+        static auto map_fill(const Engine0& vdcgen, const Engine1& cirgen, unsigned long start,
+                             std::span<Point> out) -> void {
+            auto odo0 = vdcgen.odometer(start);
+            std::array<double, FILL_BLOCK> block0;
+            std::array<std::array<Real, 2>, FILL_BLOCK> block1;
+            std::array<double, FILL_BLOCK> sines;
+            for (std::size_t k = 0; k < out.size(); k += FILL_BLOCK) {
+                const auto num = std::min(out.size() - k, FILL_BLOCK);
+                odo0.fill(std::span(block0).first(num));
+                CircleMap::unit_fill(cirgen, start + k, std::span(block1).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    block0[i] = cos_polar(block0[i]);
+                    sines[i] = 1.0 - (block0[i] * block0[i]);
+                }
+                sqrt_run(std::span(sines).first(num), std::span(sines).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[k + i] = map_point(block0[i], sines[i], block1[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the next points in the sequence
+         *
+         * @param[out] out the x, y and z arrays, of equal size
+         */
+        auto fill_soa(SoaSpan<3, Real> out) -> void {
+            this->fill_soa(this->claim(out[0].size()), out);
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the points starting at a given index
+         *
+         * Structure-of-arrays counterpart of `fill(start, out)` with identical
+         * values: coordinate k of point i goes to `out[k][i]`, so every array
+         * is written with unit stride. Does not advance the state of the
+         * generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the x, y and z arrays, of equal size
+         */
+        auto fill_soa(unsigned long start, SoaSpan<3, Real> out) const -> void {
+            std::array<Point, FILL_BLOCK> block;
+            for (std::size_t k = 0; k < out[0].size(); k += FILL_BLOCK) {
+                const auto num = std::min(out[0].size() - k, FILL_BLOCK);
+                this->fill(start + k, std::span(block).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[0][k + i] = block[i][0];
+                    out[1][k + i] = block[i][1];
+                    out[2][k + i] = block[i][2];
+                }
+            }
         }
 
         /**
@@ -685,9 +2088,20 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(const unsigned long& seed) -> void {
-            this->cirgen.reseed(seed);
-            this->vdcgen.reseed(seed);
+        auto reseed(const unsigned long& seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return BasicSphere
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicSphere {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
 
         /**
@@ -695,28 +2109,41 @@ namespace ldsgen {
          *
          * @return unsigned long current index in sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long { return this->vdcgen.get_index(); }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<Sphere, std::array<double, 3>>
+         * @return GeneratorIterator<BasicSphere, Point>
          */
-        auto begin() -> GeneratorIterator<Sphere, std::array<double, 3>> {
-            return GeneratorIterator<Sphere, std::array<double, 3>>(this);
+        [[nodiscard]] auto begin() const -> GeneratorIterator<BasicSphere, Point> {
+            return GeneratorIterator<BasicSphere, Point>(this);
         }
 
         /**
          * @brief Get iterator to end (infinite sequence)
          *
-         * @return GeneratorIterator<Sphere, std::array<double, 3>>
+         * @return GeneratorIterator<BasicSphere, Point>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<Sphere, std::array<double, 3>> {
-            return GeneratorIterator<Sphere, std::array<double, 3>>(
+        [[nodiscard]] auto end() const -> GeneratorIterator<BasicSphere, Point> {
+            return GeneratorIterator<BasicSphere, Point>(
                 nullptr, std::numeric_limits<unsigned long>::max());
         }
     };
 
+    /// Sphere sequence generator with runtime bases
+    using Sphere = BasicSphere<RadicalInverse>;
+
+    /// Single-threaded Sphere sequence generator with runtime bases
+    using LocalSphere = BasicSphere<RadicalInverse, RadicalInverse, LocalCounter>;
+
+    /// Sphere sequence generator with compile-time bases
+    template <unsigned long Base0, unsigned long Base1>
+    using SphereT = BasicSphere<RadicalInverseT<Base0>, RadicalInverseT<Base1>>;
+
+    /// Sphere sequence generator with runtime bases and float coordinates
+    using SphereF = BasicSphere<RadicalInverse, RadicalInverse, AtomicCounter, float>;
+
     /**
      * @brief S(3) sequence generator by Hopf fibration
      *
@@ -744,11 +2171,65 @@ namespace ldsgen {
      *       '.           .'
      *         '-.....-'
      * @endverbatim
+     *
+     * @tparam Engine0 radical inverse engine of phi
+     * @tparam Engine1 radical inverse engine of psi
+     * @tparam Engine2 radical inverse engine of eta
+     * @tparam Counter `AtomicCounter` or `LocalCounter`
+     * @tparam Real `double` or `float`, the coordinate type (see `BasicCircle`)
      */
-    class Sphere3Hopf {
-        VdCorput vdc0;
-        VdCorput vdc1;
-        VdCorput vdc2;
+    template <typename Engine0, typename Engine1 = Engine0, typename Engine2 = Engine0,
+              typename Counter = AtomicCounter, typename Real = double>
+    class BasicSphere3Hopf {
+        using Point = std::array<Real, 4>;
+
+        Counter count;
+        Engine0 vdc0;
+        Engine1 vdc1;
+        Engine2 vdc2;
+
+        static auto map_point(double vdc0_value, double vdc1_value, double vdc2_value)
+            -> Point {
+            auto phi = vdc0_value * TWO_PI;  // map to [0, 2*pi];
+            auto psy = vdc1_value * TWO_PI;  // map to [0, 2*pi];
+            auto vdc = vdc2_value;
+            auto cos_eta = static_cast<Real>(std::sqrt(vdc));
+            auto sin_eta = static_cast<Real>(std::sqrt(1.0 - vdc));
+            auto psy_r = static_cast<Real>(psy);
+            auto sum_r = static_cast<Real>(phi + psy);
+            return {
+                cos_eta * std::cos(psy_r),
+                cos_eta * std::sin(psy_r),
+                sin_eta * std::cos(sum_r),
+                sin_eta * std::sin(sum_r),
+            };
+        }
+
+        /// phi and psi come from `UnitRootEngine`s, which replace all four trigonometric calls
+        static constexpr bool TRIG_FREE = UnitRootEngine<Engine0> && UnitRootEngine<Engine1>;
+
+        // map_point() with (cos, sin) of phi and psi given; phi + psi is their complex product
+        static auto map_units(const std::array<double, 2>& phi, const std::array<double, 2>& psy,
+                              double vdc2_value) -> Point {
+            auto cos_eta = static_cast<Real>(std::sqrt(vdc2_value));
+            auto sin_eta = static_cast<Real>(std::sqrt(1.0 - vdc2_value));
+            const auto sum = unit_mul(phi, psy);
+            return {
+                cos_eta * static_cast<Real>(psy[0]),
+                cos_eta * static_cast<Real>(psy[1]),
+                sin_eta * static_cast<Real>(sum[0]),
+                sin_eta * static_cast<Real>(sum[1]),
+            };
+        }
+
+        /// double coordinates from plain engines take (cos, sin) from the sincos kernel
+        static constexpr bool SINCOS_KERNEL = !TRIG_FREE && std::is_same_v<Real, double>;
+
+        // map_point() with (cos, sin) of psi and of phi + psi given
+        static auto map_sincos(const std::array<double, 2>& psy, const std::array<double, 2>& sum,
+                               double cos_eta, double sin_eta) -> Point {
+            return {cos_eta * psy[0], cos_eta * psy[1], sin_eta * sum[0], sin_eta * sum[1]};
+        }
 
       public:
         /**
@@ -761,8 +2242,14 @@ namespace ldsgen {
          * @param[in] base1 the base for the second Van der Corput generator (psi coordinate)
          * @param[in] base2 the base for the third Van der Corput generator (eta coordinate)
          */
-        Sphere3Hopf(const unsigned long base0, const unsigned long base1, const unsigned long base2)
-            : vdc0(base0), vdc1(base1), vdc2(base2) {}
+        BasicSphere3Hopf(const unsigned long base0, const unsigned long base1,
+                         const unsigned long base2)
+            : count{}, vdc0(base0), vdc1(base1), vdc2(base2) {}
+
+        /**
+         * @brief Construct a new Sphere3HopfT object (compile-time bases)
+         */
+        BasicSphere3Hopf() = default;
 
         /**
          * @brief Generate the next point on the 3-sphere using Hopf fibration
@@ -770,39 +2257,17 @@ namespace ldsgen {
          * Returns the next point on the 3-sphere using the Hopf fibration as an array of four
          * double values.
          *
-         * @return std::array<double, 4> the next point on the 3-sphere
+         * @return Point the next point on the 3-sphere
          */
-        auto pop() -> std::array<double, 4> {
-            auto phi = this->vdc0.pop() * TWO_PI;  // map to [0, 2*pi];
-            auto psy = this->vdc1.pop() * TWO_PI;  // map to [0, 2*pi];
-            auto vdc = this->vdc2.pop();
-            auto cos_eta = std::sqrt(vdc);
-            auto sin_eta = std::sqrt(1.0 - vdc);
-            return {
-                cos_eta * std::cos(psy),
-                cos_eta * std::sin(psy),
-                sin_eta * std::cos(phi + psy),
-                sin_eta * std::sin(phi + psy),
-            };
-        }
+        auto pop() -> Point { return this->at(this->count.fetch_add(1)); }
 
         /**
          * @brief Peek at the next value without advancing state
          *
-         * @return std::array<double, 4> next point on the 3-sphere
+         * @return Point next point on the 3-sphere
          */
-        [[nodiscard]] auto peek() -> std::array<double, 4> {
-            auto phi = this->vdc0.peek() * TWO_PI;  // map to [0, 2*pi];
-            auto psy = this->vdc1.peek() * TWO_PI;  // map to [0, 2*pi];
-            auto vdc = this->vdc2.peek();
-            auto cos_eta = std::sqrt(vdc);
-            auto sin_eta = std::sqrt(1.0 - vdc);
-            return {
-                cos_eta * std::cos(psy),
-                cos_eta * std::sin(psy),
-                sin_eta * std::cos(phi + psy),
-                sin_eta * std::sin(phi + psy),
-            };
+        [[nodiscard]] auto peek() -> Point {
+            return this->at(this->count.load());
         }
 
         /**
@@ -810,10 +2275,144 @@ namespace ldsgen {
          *
          * @param[in] n number of values to skip
          */
-        auto skip(unsigned int n) -> void {
-            this->vdc0.skip(n);
-            this->vdc1.skip(n);
-            this->vdc2.skip(n);
+        auto skip(unsigned int n) -> void { this->count.fetch_add(n); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * Returns the point that `pop()` would produce right after `reseed(index)`.
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            if constexpr (TRIG_FREE) {
+                return map_units(this->vdc0.unit_at(index), this->vdc1.unit_at(index),
+                                 this->vdc2.at(index));
+            } else if constexpr (SINCOS_KERNEL) {
+                const auto vdc1 = this->vdc1.at(index);
+                const auto vdc2 = this->vdc2.at(index);
+                return map_sincos(sincos_turns(vdc1), sincos_turns(this->vdc0.at(index) + vdc1),
+                                  std::sqrt(vdc2), std::sqrt(1.0 - vdc2));
+            } else {
+                return map_point(this->vdc0.at(index), this->vdc1.at(index),
+                                 this->vdc2.at(index));
+            }
+        }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<Point> out) -> void {
+            this->fill(this->claim(out.size()), out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         */
+        auto fill(unsigned long start, std::span<Point> out) const -> void {
+            if constexpr (TRIG_FREE) {
+                auto odo0 = this->vdc0.unit_odometer(start);
+                auto odo1 = this->vdc1.unit_odometer(start);
+                auto odo2 = this->vdc2.odometer(start);
+                std::array<std::array<double, 2>, FILL_BLOCK> block0;
+                std::array<std::array<double, 2>, FILL_BLOCK> block1;
+                std::array<double, FILL_BLOCK> block2;
+                for (std::size_t k = 0; k < out.size(); k += FILL_BLOCK) {
+                    const auto num = std::min(out.size() - k, FILL_BLOCK);
+                    odo0.fill(std::span(block0).first(num));
+                    odo1.fill(std::span(block1).first(num));
+                    odo2.fill(std::span(block2).first(num));
+                    for (std::size_t i = 0; i < num; ++i) {
+                        out[k + i] = map_units(block0[i], block1[i], block2[i]);
+                    }
+                }
+            } else if constexpr (SINCOS_KERNEL) {
+                auto odo0 = this->vdc0.odometer(start);
+                auto odo1 = this->vdc1.odometer(start);
+                auto odo2 = this->vdc2.odometer(start);
+                std::array<double, FILL_BLOCK> turns0;  // phi + psi, in turns
+                std::array<double, FILL_BLOCK> turns1;
+                std::array<double, FILL_BLOCK> cos_eta;
+                std::array<double, FILL_BLOCK> sin_eta;
+                std::array<std::array<double, 2>, FILL_BLOCK> sum;
+                std::array<std::array<double, 2>, FILL_BLOCK> psy;
+                for (std::size_t k = 0; k < out.size(); k += FILL_BLOCK) {
+                    const auto num = std::min(out.size() - k, FILL_BLOCK);
+                    odo0.fill(std::span(turns0).first(num));
+                    odo1.fill(std::span(turns1).first(num));
+                    odo2.fill(std::span(cos_eta).first(num));
+                    for (std::size_t i = 0; i < num; ++i) {
+                        turns0[i] += turns1[i];
+                        sin_eta[i] = 1.0 - cos_eta[i];
+                    }
+                    sincos_run(std::span(turns0).first(num), std::span(sum).first(num));
+                    sincos_run(std::span(turns1).first(num), std::span(psy).first(num));
+                    sqrt_run(std::span(cos_eta).first(num), std::span(cos_eta).first(num));
+                    sqrt_run(std::span(sin_eta).first(num), std::span(sin_eta).first(num));
+                    for (std::size_t i = 0; i < num; ++i) {
+                        out[k + i] = map_sincos(psy[i], sum[i], cos_eta[i], sin_eta[i]);
+                    }
+                }
+            } else {
+                auto odo0 = this->vdc0.odometer(start);
+                auto odo1 = this->vdc1.odometer(start);
+                auto odo2 = this->vdc2.odometer(start);
+                for (auto& point : out) {
+                    point = map_point(odo0.pop(), odo1.pop(), odo2.pop());
+                }
+            }
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the next points in the sequence
+         *
+         * @param[out] out the four coordinate arrays, of equal size
+         */
+        auto fill_soa(SoaSpan<4, Real> out) -> void {
+            this->fill_soa(this->claim(out[0].size()), out);
+        }
+
+        /**
+         * @brief Fill coordinate arrays with the points starting at a given index
+         *
+         * Structure-of-arrays counterpart of `fill(start, out)` with identical
+         * values: coordinate k of point i goes to `out[k][i]`, so every array
+         * is written with unit stride. Does not advance the state of the
+         * generator.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the four coordinate arrays, of equal size
+         */
+        auto fill_soa(unsigned long start, SoaSpan<4, Real> out) const -> void {
+            std::array<Point, FILL_BLOCK> block;
+            for (std::size_t k = 0; k < out[0].size(); k += FILL_BLOCK) {
+                const auto num = std::min(out[0].size() - k, FILL_BLOCK);
+                this->fill(start + k, std::span(block).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    out[0][k + i] = block[i][0];
+                    out[1][k + i] = block[i][1];
+                    out[2][k + i] = block[i][2];
+                    out[3][k + i] = block[i][3];
+                }
+            }
         }
 
         /**
@@ -823,10 +2422,20 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(unsigned long seed) -> void {
-            this->vdc0.reseed(seed);
-            this->vdc1.reseed(seed);
-            this->vdc2.reseed(seed);
+        auto reseed(unsigned long seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return BasicSphere3Hopf
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> BasicSphere3Hopf {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
 
         /**
@@ -834,28 +2443,125 @@ namespace ldsgen {
          *
          * @return unsigned long current index in sequence
          */
-        [[nodiscard]] auto get_index() const -> unsigned long { return this->vdc0.get_index(); }
+        [[nodiscard]] auto get_index() const -> unsigned long { return this->count.load(); }
 
         /**
          * @brief Get iterator to beginning
          *
-         * @return GeneratorIterator<Sphere3Hopf, std::array<double, 4>>
+         * @return GeneratorIterator<BasicSphere3Hopf, Point>
          */
-        auto begin() -> GeneratorIterator<Sphere3Hopf, std::array<double, 4>> {
-            return GeneratorIterator<Sphere3Hopf, std::array<double, 4>>(this);
+        [[nodiscard]] auto begin() const
+            -> GeneratorIterator<BasicSphere3Hopf, Point> {
+            return GeneratorIterator<BasicSphere3Hopf, Point>(this);
         }
 
         /**
          * @brief Get iterator to end (infinite sequence)
          *
-         * @return GeneratorIterator<Sphere3Hopf, std::array<double, 4>>
+         * @return GeneratorIterator<BasicSphere3Hopf, Point>
          */
-        [[nodiscard]] auto end() const -> GeneratorIterator<Sphere3Hopf, std::array<double, 4>> {
-            return GeneratorIterator<Sphere3Hopf, std::array<double, 4>>(
+        [[nodiscard]] auto end() const
+            -> GeneratorIterator<BasicSphere3Hopf, Point> {
+            return GeneratorIterator<BasicSphere3Hopf, Point>(
                 nullptr, std::numeric_limits<unsigned long>::max());
         }
     };
 
+    /// S(3) sequence generator by Hopf fibration with runtime bases
+    using Sphere3Hopf = BasicSphere3Hopf<RadicalInverse>;
+
+    /// Single-threaded S(3) sequence generator by Hopf fibration with runtime bases
+    using LocalSphere3Hopf
+        = BasicSphere3Hopf<RadicalInverse, RadicalInverse, RadicalInverse, LocalCounter>;
+
+    /// S(3) sequence generator by Hopf fibration with compile-time bases
+    template <unsigned long Base0, unsigned long Base1, unsigned long Base2>
+    using Sphere3HopfT
+        = BasicSphere3Hopf<RadicalInverseT<Base0>, RadicalInverseT<Base1>, RadicalInverseT<Base2>>;
+
+    /// S(3) sequence generator by Hopf fibration with runtime bases and float coordinates
+    using Sphere3HopfF = BasicSphere3Hopf<RadicalInverse, RadicalInverse, RadicalInverse,
+                                          AtomicCounter, float>;
+
+    /**
+     * @brief Per-thread handle that claims indices of a shared generator in blocks
+     *
+     * Each worker thread owns one cursor on a shared generator. When its block
+     * is used up, the cursor claims the next `block_size` indices with a single
+     * `claim()` (one atomic operation on the generator's counter) and
+     * generates the whole block locally with `fill(start, ...)`; `pop()` then
+     * hands the points out without touching shared state. Together the
+     * threads still produce a permutation of the sequence, but contention on
+     * the counter drops by a factor of `block_size`.
+     *
+     * The cursor is aligned to a cache line, so cursors of different threads
+     * kept in one array do not share one.
+     *
+     * @verbatim
+     *     Sphere sgen(2, 3);   // shared by all threads
+     *     // in each thread:
+     *     BlockCursor cursor(sgen);
+     *     auto point = cursor.pop();
+     * @endverbatim
+     *
+     * @tparam Generator a generator with `claim(n)` and `fill(start, out)`
+     */
+    template <typename Generator> class alignas(CACHE_LINE_SIZE) BlockCursor {
+      public:
+        using value_type = decltype(std::declval<const Generator&>().at(0));
+
+      private:
+        Generator* gen;
+        std::vector<value_type> block;
+        std::size_t pos;
+        unsigned long start{0};
+
+      public:
+        /**
+         * @brief Construct a new BlockCursor object
+         *
+         * Does not claim anything until the first `pop()`.
+         *
+         * @param[in] gen the shared generator, which must outlive the cursor
+         * @param[in] block_size the number of indices claimed at a time
+         */
+        explicit BlockCursor(Generator& gen, std::size_t block_size = CURSOR_BLOCK)
+            : gen{&gen}, block(std::max(block_size, std::size_t(1))), pos{block.size()} {}
+
+        /**
+         * @brief Get the next point of this cursor
+         *
+         * @return value_type the point at the next index claimed by this cursor
+         */
+        auto pop() -> value_type {
+            if (this->pos == this->block.size()) {
+                this->start = this->gen->claim(this->block.size());
+                this->gen->fill(this->start, std::span(this->block));
+                this->pos = 0;
+            }
+            return this->block[this->pos++];
+        }
+
+        /**
+         * @brief Get the index of the point the last `pop()` returned
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] auto get_index() const -> unsigned long {
+            return this->start + this->pos - 1;
+        }
+
+        /**
+         * @brief Get the number of indices claimed at a time
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] auto get_block_size() const -> std::size_t { return this->block.size(); }
+    };
+
+    /// @brief First 1000 prime numbers, for use as bases (defined in lds.cpp)
+    extern const std::array<unsigned long, 1000> PRIME_TABLE;
+
     /**
      * @brief Dummy function (placeholder, not yet implemented).
      * @param[in] index The input index.
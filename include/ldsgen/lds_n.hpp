@@ -4,7 +4,12 @@
  *  @brief N-dimensional Halton sequence generator with runtime polymorphism.
  */
 
-#include <memory>  // for unique_ptr
+#include <algorithm>  // for min
+#include <array>      // for array
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int32_t
+#include <span>       // for span
+#include <stdexcept>  // for invalid_argument
 
 // #include <algorithm>  // for std::transform
 // #include <iterator>
@@ -15,6 +20,99 @@
 namespace ldsgen {
     using std::vector;
 
+    /// Number of dimensions `halton_point()` processes in lockstep
+    constexpr std::size_t HALTON_LANES = 8;
+    /// Upper bound on the digit steps of a count below `LANE_COUNT_LIMIT` in any lane (base 3)
+    constexpr std::size_t LANE_DIGITS = 28;
+    /// Counts handled by `halton_point()` must be below 2^52, so that doubles divide exactly
+    constexpr unsigned long LANE_COUNT_LIMIT = 1UL << 52U;
+
+    /**
+     * @brief Dimension-major description of the bases of a `HaltonN`
+     *
+     * Holds, for every dimension ("lane"), what `RadicalInverse` uses to
+     * turn a count into a value, laid out so that `HALTON_LANES` consecutive
+     * dimensions load into one vector register. The lane count is padded up
+     * to a multiple of `HALTON_LANES`; padding lanes have a zero weight.
+     *
+     * A lane takes the lowest chunk of digits in one step (radix b^k and a
+     * digit-chunk table for bases up to `MAX_CHUNK_BASE`, radix b and weight
+     * 1/b otherwise), then one digit per step. Base 2 is described as 10-bit
+     * chunks of `CHUNK_TABLE<2>` throughout, which is exact and therefore
+     * equal to `vdc_base2()` for counts below 2^53.
+     */
+    struct HaltonLanes {
+        std::size_t dim{0};                ///< number of dimensions
+        vector<double> radix;              ///< radix of the lowest chunk of each lane
+        vector<double> inv_radix;          ///< 1 / radix
+        vector<std::int32_t> offset;       ///< offset of its table in `tables`, or -1
+        vector<double> high_radix;         ///< radix of the steps above the lowest chunk
+        vector<double> inv_high_radix;     ///< 1 / high_radix
+        vector<std::int32_t> high_offset;  ///< offset of their table in `tables`, or -1
+        vector<double> weights;            ///< weights[i * radix.size() + lane] of step i
+        vector<double> tables;             ///< the digit-chunk tables of all lanes
+
+        /**
+         * @brief Construct a new HaltonLanes object
+         *
+         * @param[in] base the bases of the dimensions
+         */
+        explicit HaltonLanes(const vector<unsigned long>& base) : dim{base.size()} {
+            constexpr auto PADDING_RADIX = double(1UL << 30U);  // any radix with few digits
+            const auto num_lanes = (this->dim + HALTON_LANES - 1) / HALTON_LANES * HALTON_LANES;
+            this->radix.assign(num_lanes, PADDING_RADIX);
+            this->inv_radix.assign(num_lanes, 1.0 / PADDING_RADIX);
+            this->offset.assign(num_lanes, -1);
+            this->high_radix.assign(num_lanes, PADDING_RADIX);
+            this->inv_high_radix.assign(num_lanes, 1.0 / PADDING_RADIX);
+            this->high_offset.assign(num_lanes, -1);
+            this->weights.assign(LANE_DIGITS * num_lanes, 0.0);
+            for (std::size_t lane = 0; lane < this->dim; ++lane) {
+                const auto lane_base = base[lane];
+                const auto* chunk_lst
+                    = lane_base == 2 ? CHUNK_TABLE<2>.data() : chunk_table(lane_base);
+                const auto lane_radix = chunk_lst != nullptr ? chunk_radix(lane_base) : lane_base;
+                const auto rev_lst
+                    = lane_base == 2 ? chunk_weights(lane_radix) : reciprocal_powers(lane_base);
+                // a digit-chunk table stands for the lowest k digits, with weight 1
+                const bool chunked = lane_base != 2 && chunk_lst != nullptr;
+                const auto skip = chunked ? chunk_digits(lane_base) - 1 : 0;
+                this->radix[lane] = double(lane_radix);
+                this->inv_radix[lane] = 1.0 / double(lane_radix);
+                this->high_radix[lane] = double(lane_base == 2 ? lane_radix : lane_base);
+                this->inv_high_radix[lane] = 1.0 / this->high_radix[lane];
+                if (chunk_lst != nullptr) {
+                    this->offset[lane] = static_cast<std::int32_t>(this->tables.size());
+                    if (lane_base == 2) {
+                        this->high_offset[lane] = this->offset[lane];
+                    }
+                    this->tables.insert(this->tables.end(), chunk_lst, chunk_lst + lane_radix);
+                }
+                for (std::size_t i = 0; i < LANE_DIGITS; ++i) {
+                    this->weights[i * num_lanes + lane]
+                        = chunked && i == 0 ? 1.0 : rev_lst[skip + i];
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Lockstep kernel: the values of all lanes for one count
+     *
+     * Runs the digit loops of `HALTON_LANES` dimensions at a time in vector
+     * lanes (AVX-512F or AVX2, with a scalar fallback, selected at runtime
+     * like `vdc_run()`), until the lane with the most digits is done. The
+     * digits are divided off in double precision, hence the count limit, and
+     * accumulated least significant first, so the values are bit-identical
+     * to `VdCorput::at()`. Defined in vdc_kernel.cpp.
+     *
+     * @param[in] lanes the bases
+     * @param[in] count the count, below `LANE_COUNT_LIMIT`
+     * @param[out] out the coordinates, `lanes.dim` long
+     */
+    extern auto halton_point(const HaltonLanes& lanes, unsigned long count, std::span<double> out)
+        -> void;
+
     /**
      * @brief Halton(n) sequence generator
      *
@@ -33,10 +131,27 @@ namespace ldsgen {
      *     pop() -> [0.75, 0.111, 0.6]   (etc...)
      *     ...
      * @endverbatim
+     *
+     * The radical inverse engines of the dimensions are kept by value, side
+     * by side; a `HaltonN` is a copyable value like the other generators.
      */
     class HaltonN {
       private:
-        vector<std::unique_ptr<VdCorput>> vdcs;
+        AtomicCounter count;
+        vector<RadicalInverse> vdcs;
+        HaltonLanes lanes;
+
+        auto check_point(std::span<const double> out) const -> void {
+            if (out.size() < this->vdcs.size()) {
+                throw std::invalid_argument("HaltonN needs one coordinate per dimension");
+            }
+        }
+
+        auto check_points(std::span<const double> out) const -> void {
+            if (this->vdcs.empty() || out.size() % this->vdcs.size() != 0) {
+                throw std::invalid_argument("HaltonN needs whole points of dimension coordinates");
+            }
+        }
 
       public:
         /**
@@ -45,13 +160,25 @@ namespace ldsgen {
          * Constructs an N-dimensional Halton sequence generator with the specified bases.
          *
          * @param[in] base vector of unsigned long values representing the bases for each dimension
+         * @throw std::invalid_argument if `base` is empty
          */
-        explicit HaltonN(const vector<unsigned long>& base) {
+        explicit HaltonN(const vector<unsigned long>& base) : count{}, lanes{base} {
+            if (base.empty()) {
+                throw std::invalid_argument("HaltonN requires at least 1 base");
+            }
+            this->vdcs.reserve(base.size());
             for (const auto& base_value : base) {
-                this->vdcs.emplace_back(std::make_unique<ldsgen::VdCorput>(base_value));
+                this->vdcs.emplace_back(base_value);
             }
         }
 
+        /**
+         * @brief Get the number of dimensions
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] auto get_dim() const -> std::size_t { return this->vdcs.size(); }
+
         /**
          * @brief Generate the next point in the N-dimensional Halton sequence
          *
@@ -60,13 +187,99 @@ namespace ldsgen {
          * @return vector<double> the next point in the sequence
          */
         auto pop() -> vector<double> {
-            auto res = vector<double>{};
-            for (auto& vdc : this->vdcs) {
-                res.emplace_back(vdc->pop());
-            }
+            auto res = vector<double>(this->vdcs.size());
+            this->pop(res);
             return res;
         }
 
+        /**
+         * @brief Write the next point into a caller-provided buffer
+         *
+         * Does not allocate.
+         *
+         * @param[out] out the coordinates, one per dimension
+         * @throw std::invalid_argument if `out` is shorter than the dimension
+         */
+        auto pop(std::span<double> out) -> void {
+            this->check_point(out);
+            this->at(this->claim(1), out);
+        }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * All dimensions are computed together by `halton_point()`.
+         *
+         * @param[in] index the index in the sequence
+         * @param[out] out the coordinates, one per dimension
+         * @throw std::invalid_argument if `out` is shorter than the dimension
+         */
+        auto at(unsigned long index, std::span<double> out) const -> void {
+            this->check_point(out);
+            if (index < LANE_COUNT_LIMIT - 1) {
+                halton_point(this->lanes, index + 1, out.first(this->vdcs.size()));
+                return;
+            }
+            for (std::size_t j = 0; j < this->vdcs.size(); ++j) {
+                out[j] = this->vdcs[j].at(index);
+            }
+        }
+
+        /**
+         * @brief Claim a range of indices with a single atomic operation
+         *
+         * @param[in] n number of indices to claim
+         * @return unsigned long the first claimed index
+         */
+        auto claim(std::size_t n) -> unsigned long {
+            return this->count.fetch_add(static_cast<unsigned long>(n));
+        }
+
+        /**
+         * @brief Fill a buffer with the next points in the sequence
+         *
+         * The points are stored row-major: `out.size() / dimension` points of
+         * `dimension` coordinates each.
+         *
+         * @param[out] out the buffer to fill
+         * @throw std::invalid_argument if `out.size()` is not a multiple of the dimension
+         */
+        auto fill(std::span<double> out) -> void {
+            this->check_points(out);
+            this->fill(this->claim(out.size() / this->vdcs.size()), out);
+        }
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator. The points are stored
+         * row-major, as in `fill(out)`.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill
+         * @throw std::invalid_argument if `out.size()` is not a multiple of the dimension
+         */
+        auto fill(unsigned long start, std::span<double> out) const -> void {
+            this->check_points(out);
+            const auto dim = this->vdcs.size();
+            const auto num_points = out.size() / dim;
+            auto odos = vector<VdcOdometer>{};
+            odos.reserve(dim);
+            for (const auto& vdc : this->vdcs) {
+                odos.emplace_back(vdc.odometer(start));
+            }
+            std::array<double, FILL_BLOCK> block;
+            for (std::size_t k = 0; k < num_points; k += FILL_BLOCK) {
+                const auto num = std::min(num_points - k, FILL_BLOCK);
+                for (std::size_t j = 0; j < dim; ++j) {
+                    odos[j].fill(std::span(block).first(num));
+                    for (std::size_t i = 0; i < num; ++i) {
+                        out[(k + i) * dim + j] = block[i];
+                    }
+                }
+            }
+        }
+
         /**
          * @brief Reset the state of the HaltonN sequence generator
          *
@@ -74,10 +287,20 @@ namespace ldsgen {
          *
          * @param[in] seed the seed value to reset the sequence generator to
          */
-        auto reseed(unsigned long seed) -> void {
-            for (auto& vdc : this->vdcs) {
-                vdc->reseed(seed);
-            }
+        auto reseed(unsigned long seed) -> void { this->count.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return HaltonN
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> HaltonN {
+            auto copy = *this;
+            copy.count.store(start);
+            return copy;
         }
     };
 
@@ -0,0 +1,134 @@
+#pragma once
+
+/** @file parallel.hpp
+ *  @brief Multi-threaded batch generation on a work-stealing scheduler.
+ */
+
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <span>        // for span
+#include <stdexcept>   // for invalid_argument
+#include <utility>     // for declval
+
+#include "lds.hpp"    // for Halton, Sphere, ...
+#include "lds_n.hpp"  // for HaltonN
+
+namespace ldsgen {
+
+    /// Smallest number of points a `parallel_fill()` task generates
+    constexpr std::size_t PARALLEL_GRAIN = 4096;
+    /// Number of tasks per thread a range is cut into, the slack for load balancing
+    constexpr std::size_t TASKS_PER_THREAD = 16;
+
+    /// The point type a generator's `at()` returns
+    template <typename Generator> using point_type_t
+        = decltype(std::declval<const Generator&>().at(0));
+
+    /**
+     * @brief Run a loop over [0, num_items) on several threads
+     *
+     * The range is cut into tasks of at least `grain` items, and every thread
+     * starts with an equal, contiguous share of them. A thread takes tasks from
+     * the front of its own share; once that is empty it steals half of the
+     * tasks left at the back of another thread's share. Both ends of a share
+     * are packed into one atomic word, so taking and stealing are a single
+     * compare-and-swap each.
+     *
+     * The threads come from a pool of one per CPU the process may run on
+     * (pinned to it, on Linux), started by the first call that needs more
+     * than one and kept until the program exits; `num_threads` is capped at
+     * its size. The calling thread waits for the
+     * workers, and calls from other threads wait for the pool. Calls from
+     * within `body` run on the calling worker alone. The first exception
+     * thrown by `body` is rethrown after all threads finish; if a thread of
+     * the pool cannot be started, the ones already running are joined before
+     * the `std::system_error` propagates, and the next call tries again.
+     *
+     * Defined in parallel.cpp.
+     *
+     * @param[in] num_items the number of items
+     * @param[in] grain the smallest number of items of a task
+     * @param[in] num_threads the number of threads, or 0 for one per hardware thread
+     * @param[in] body called with the [begin, end) of each task, from any thread
+     */
+    extern auto parallel_for(std::size_t num_items, std::size_t grain, unsigned int num_threads,
+                             const std::function<void(std::size_t, std::size_t)>& body) -> void;
+
+    /**
+     * @brief Run a loop over [0, num_items) on several threads, in fixed shares
+     *
+     * Cuts the range into `num_threads` contiguous shares, at multiples of
+     * `grain`, and calls `body` once for share i, on thread i of the pool of
+     * `parallel_for()`; nothing is stolen. Even a single share runs on the
+     * pool. As the threads of the pool are pinned, two calls with the same
+     * `num_items`, `grain` and `num_threads` run each item on the same CPU,
+     * which is what NUMA first-touch placement relies on. Otherwise as
+     * `parallel_for()`. Defined in parallel.cpp.
+     *
+     * @param[in] num_items the number of items
+     * @param[in] grain the granularity of the shares
+     * @param[in] num_threads the number of threads, or 0 for one per hardware thread
+     * @param[in] body called with the [begin, end) of each share, from its thread
+     */
+    extern auto parallel_for_static(std::size_t num_items, std::size_t grain,
+                                    unsigned int num_threads,
+                                    const std::function<void(std::size_t, std::size_t)>& body)
+        -> void;
+
+    /**
+     * @brief Fill a buffer with the points starting at a given index, on several threads
+     *
+     * Each task runs the generator's sequential batch path,
+     * `gen.fill(first + begin, ...)`, on its own slice of `out`. The result
+     * is identical to `gen.fill(first, out)` whatever the number of threads.
+     * Does not advance the state of the generator.
+     *
+     * @verbatim
+     *     Sphere sgen(2, 3);
+     *     std::vector<std::array<double, 3>> points(1'000'000'000);
+     *     parallel_fill(sgen, 0, points);
+     * @endverbatim
+     *
+     * @param[in] gen the generator
+     * @param[in] first the index of the first point
+     * @param[out] out the buffer to fill
+     * @param[in] num_threads the number of threads, or 0 for one per hardware thread
+     */
+    template <typename Generator>
+    auto parallel_fill(const Generator& gen, unsigned long first,
+                       std::span<point_type_t<Generator>> out, unsigned int num_threads = 0)
+        -> void {
+        parallel_for(out.size(), PARALLEL_GRAIN, num_threads,
+                     [&](std::size_t begin, std::size_t end) {
+                         gen.fill(first + begin, out.subspan(begin, end - begin));
+                     });
+    }
+
+    /**
+     * @brief Fill a buffer with the points of a HaltonN starting at a given index
+     *
+     * The points are stored row-major, as in `HaltonN::fill(start, out)`,
+     * and are identical to it whatever the number of threads.
+     *
+     * @param[in] gen the generator
+     * @param[in] first the index of the first point
+     * @param[out] out the buffer to fill
+     * @param[in] num_threads the number of threads, or 0 for one per hardware thread
+     * @throw std::invalid_argument if `out.size()` is not a multiple of the dimension
+     */
+    inline auto parallel_fill(const HaltonN& gen, unsigned long first, std::span<double> out,
+                              unsigned int num_threads = 0) -> void {
+        const auto dim = gen.get_dim();
+        if (dim == 0) {
+            return;  // a moved-from HaltonN
+        }
+        if (out.size() % dim != 0) {
+            throw std::invalid_argument("HaltonN needs whole points of dimension coordinates");
+        }
+        parallel_for(out.size() / dim, PARALLEL_GRAIN, num_threads,
+                     [&](std::size_t begin, std::size_t end) {
+                         gen.fill(first + begin, out.subspan(begin * dim, (end - begin) * dim));
+                     });
+    }
+
+}  // namespace ldsgen
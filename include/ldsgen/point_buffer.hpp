@@ -0,0 +1,240 @@
+#pragma once
+
+/** @file point_buffer.hpp
+ *  @brief Aligned, optionally huge-page backed buffers for large batches of points.
+ */
+
+#include <algorithm>    // for min
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <span>         // for span
+#include <type_traits>  // for conditional_t, is_same_v, type_identity_t
+#include <utility>      // for exchange
+
+#include "parallel.hpp"  // for parallel_for_static, point_type_t
+
+namespace ldsgen {
+
+    /// Alignment of a `PointBuffer`, one cache line
+    constexpr std::size_t BUFFER_ALIGNMENT = 64;
+    /// Size of a transparent huge page on x86-64 and AArch64 Linux
+    constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20U;
+    /// Buffers larger than this (about a last-level cache) are filled with non-temporal stores
+    constexpr std::size_t STREAM_THRESHOLD = std::size_t(32) << 20U;
+
+    /**
+     * @brief Allocate memory for a point buffer
+     *
+     * Returns memory aligned to `BUFFER_ALIGNMENT`. With `huge_pages` on Linux
+     * it is an anonymous mapping aligned to `HUGE_PAGE_SIZE` and advised for
+     * transparent huge pages; elsewhere the flag is ignored. The pages are not
+     * touched. Defined in point_buffer.cpp.
+     *
+     * @param[in] bytes the size in bytes
+     * @param[in] huge_pages whether to back the memory with huge pages
+     * @return void* the memory
+     */
+    extern auto allocate_points(std::size_t bytes, bool huge_pages) -> void*;
+
+    /**
+     * @brief Free memory from `allocate_points()`
+     *
+     * @param[in] ptr the memory
+     * @param[in] bytes the size given to `allocate_points()`
+     * @param[in] huge_pages the flag given to `allocate_points()`
+     */
+    extern auto deallocate_points(void* ptr, std::size_t bytes, bool huge_pages) -> void;
+
+    /**
+     * @brief Copy coordinates with non-temporal (cache-bypassing) stores
+     *
+     * Uses SSE streaming stores on x86, a plain copy elsewhere, and ends with
+     * a store fence. Defined in point_buffer.cpp for `double` and `float`.
+     *
+     * @tparam Real the coordinate type, `double` or `float`
+     * @param[in] src the values
+     * @param[out] dst the destination, `src.size()` long
+     */
+    template <typename Real>
+    auto stream_copy(std::span<const std::type_identity_t<Real>> src, std::span<Real> dst)
+        -> void;
+
+    extern template auto stream_copy<double>(std::span<const double> src,
+                                             std::span<double> dst) -> void;
+    extern template auto stream_copy<float>(std::span<const float> src, std::span<float> dst)
+        -> void;
+
+    /// The coordinate type of a point: the point itself for 1-D generators
+    template <typename Point> struct coordinate_type {
+        using type = Point;
+    };
+
+    template <typename Real, std::size_t N> struct coordinate_type<std::array<Real, N>> {
+        using type = Real;
+    };
+
+    /// The coordinate type of a point, `double` or `float`
+    template <typename Point> using coordinate_type_t = typename coordinate_type<Point>::type;
+
+    /**
+     * @brief Fill a buffer with non-temporal stores
+     *
+     * Generates `FILL_BLOCK` points at a time into a block that stays in L1
+     * with `gen.fill(start, ...)` and streams the block out with
+     * `stream_copy()`, so that writing an output much larger than the cache
+     * neither reads the destination lines first nor evicts the tables the
+     * generator uses. The result is identical to `gen.fill(first, out)`.
+     *
+     * @param[in] gen the generator, with `double` or `float` coordinates
+     * @param[in] first the index of the first point
+     * @param[out] out the buffer to fill
+     */
+    template <typename Generator>
+    auto stream_fill(const Generator& gen, unsigned long first,
+                     std::span<point_type_t<Generator>> out) -> void {
+        using Point = point_type_t<Generator>;
+        using Real = coordinate_type_t<Point>;
+        constexpr auto WIDTH = sizeof(Point) / sizeof(Real);
+        static_assert(sizeof(Point) == WIDTH * sizeof(Real), "points must not be padded");
+        // the coordinates of consecutive points, as one contiguous run
+        constexpr auto coordinates = [](auto& point) {
+            if constexpr (std::is_same_v<Point, Real>) {
+                return &point;
+            } else {
+                return point.data();
+            }
+        };
+        std::array<Point, FILL_BLOCK> block;
+        for (std::size_t k = 0; k < out.size(); k += FILL_BLOCK) {
+            const auto num = std::min(out.size() - k, FILL_BLOCK);
+            gen.fill(first + k, std::span(block).first(num));
+            stream_copy(std::span<const Real>(coordinates(block[0]), num * WIDTH),
+                        std::span<Real>(coordinates(out[k]), num * WIDTH));
+        }
+    }
+
+    /**
+     * @brief Buffer for a large batch of D-dimensional points
+     *
+     * The storage is aligned to a cache line and, optionally, backed by 2 MiB
+     * huge pages, which cuts TLB misses when filling and reading gigabytes of
+     * points. The constructor first-touches the pages with
+     * `parallel_for_static()` in the same shares as `fill()`, so that on a
+     * NUMA machine (Linux, whose pool threads are pinned) each share lands on
+     * the node of the CPU that will fill it, as long as the same number of
+     * threads is used for both. Only the pages that straddle two shares may
+     * end up on the other node.
+     *
+     * @verbatim
+     *     PointBuffer<3> points(1'000'000'000, 0, true);
+     *     points.fill(Sphere(2, 3), 0);
+     * @endverbatim
+     *
+     * @tparam D the dimension of the points; points of dimension 1 are plain doubles
+     */
+    template <std::size_t D> class PointBuffer {
+        static_assert(D >= 1, "D must be at least 1");
+
+      public:
+        using value_type = std::conditional_t<D == 1, double, std::array<double, D>>;
+
+      private:
+        value_type* ptr{nullptr};
+        std::size_t count{0};
+        bool huge_pages{false};
+
+      public:
+        /**
+         * @brief Construct a new PointBuffer object
+         *
+         * The points are zeroed.
+         *
+         * @param[in] size the number of points
+         * @param[in] num_threads the number of threads that first-touch (and will fill) the
+         * buffer, or 0 for one per hardware thread
+         * @param[in] huge_pages whether to back the buffer with huge pages
+         */
+        explicit PointBuffer(std::size_t size, unsigned int num_threads = 0,
+                             bool huge_pages = false)
+            : ptr{static_cast<value_type*>(allocate_points(size * sizeof(value_type), huge_pages))},
+              count{size},
+              huge_pages{huge_pages} {
+            parallel_for_static(size, PARALLEL_GRAIN, num_threads,
+                                [this](std::size_t begin, std::size_t end) {
+                                    std::fill(this->ptr + begin, this->ptr + end, value_type{});
+                                });
+        }
+
+        ~PointBuffer() {
+            if (this->ptr != nullptr) {
+                deallocate_points(this->ptr, this->count * sizeof(value_type), this->huge_pages);
+            }
+        }
+
+        PointBuffer(const PointBuffer&) = delete;
+        auto operator=(const PointBuffer&) -> PointBuffer& = delete;
+
+        PointBuffer(PointBuffer&& other) noexcept
+            : ptr{std::exchange(other.ptr, nullptr)},
+              count{std::exchange(other.count, 0)},
+              huge_pages{other.huge_pages} {}
+
+        auto operator=(PointBuffer&& other) noexcept -> PointBuffer& {
+            std::swap(this->ptr, other.ptr);
+            std::swap(this->count, other.count);
+            std::swap(this->huge_pages, other.huge_pages);
+            return *this;
+        }
+
+        /**
+         * @brief Fill the buffer with the points starting at a given index
+         *
+         * Runs in the shares the constructor first-touched, with
+         * `parallel_for_static()`; buffers larger than `STREAM_THRESHOLD` are
+         * written with `stream_fill()`. The result is identical to the serial
+         * `gen.fill(first, ...)`.
+         *
+         * @param[in] gen the generator, whose points must be `value_type`
+         * @param[in] first the index of the first point
+         * @param[in] num_threads the number of threads, or 0 for one per hardware thread
+         */
+        template <typename Generator>
+        auto fill(const Generator& gen, unsigned long first, unsigned int num_threads = 0)
+            -> void {
+            const auto streaming = this->count * sizeof(value_type) > STREAM_THRESHOLD;
+            parallel_for_static(this->count, PARALLEL_GRAIN, num_threads,
+                                [&](std::size_t begin, std::size_t end) {
+                                    const auto out = this->span().subspan(begin, end - begin);
+                                    if (streaming) {
+                                        stream_fill(gen, first + begin, out);
+                                    } else {
+                                        gen.fill(first + begin, out);
+                                    }
+                                });
+        }
+
+        /**
+         * @brief Get the points as a span
+         *
+         * @return std::span<value_type>
+         */
+        [[nodiscard]] auto span() -> std::span<value_type> {
+            return std::span(this->ptr, this->count);
+        }
+
+        [[nodiscard]] auto span() const -> std::span<const value_type> {
+            return std::span<const value_type>(this->ptr, this->count);
+        }
+
+        [[nodiscard]] auto data() -> value_type* { return this->ptr; }
+        [[nodiscard]] auto data() const -> const value_type* { return this->ptr; }
+        [[nodiscard]] auto size() const -> std::size_t { return this->count; }
+        [[nodiscard]] auto begin() -> value_type* { return this->ptr; }
+        [[nodiscard]] auto begin() const -> const value_type* { return this->ptr; }
+        [[nodiscard]] auto end() -> value_type* { return this->ptr + this->count; }
+        [[nodiscard]] auto end() const -> const value_type* { return this->ptr + this->count; }
+        auto operator[](std::size_t i) -> value_type& { return this->ptr[i]; }
+        auto operator[](std::size_t i) const -> const value_type& { return this->ptr[i]; }
+    };
+
+}  // namespace ldsgen
@@ -0,0 +1,106 @@
+#pragma once
+
+/** @file soa.hpp
+ *  @brief Structure-of-arrays views and cache-blocked transposes between point layouts.
+ */
+
+#include <algorithm>    // for min
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <span>         // for span
+#include <type_traits>  // for type_identity_t
+
+namespace ldsgen {
+
+    /// Number of points a transpose moves at a time (with D <= 8, 4 KiB of input, L1 resident)
+    constexpr std::size_t TRANSPOSE_BLOCK = 64;
+
+    /**
+     * @brief Structure-of-arrays view of a batch of N-dimensional points
+     *
+     * `out[k][i]` is coordinate k of point i. All N spans have the same size.
+     * `Real` is the coordinate type, `double` or `float`.
+     *
+     * @verbatim
+     *     std::vector<double> xs(1000), ys(1000), zs(1000);
+     *     Sphere(2, 3).fill_soa(0, {xs, ys, zs});
+     * @endverbatim
+     */
+    template <std::size_t N, typename Real = double> using SoaSpan
+        = std::array<std::span<Real>, N>;
+
+    /**
+     * @brief Transpose a row-major matrix into a column-major one
+     *
+     * Copies the `rows` x `cols` matrix `in` (row-major) to `out`
+     * (column-major, i.e. `out[c * rows + r] = in[r * cols + c]`). The rows
+     * are moved `TRANSPOSE_BLOCK` at a time, and within a block column by
+     * column, so every output column is written with unit stride while the
+     * block being read stays in L1. This turns the row-major output of
+     * `HaltonN::fill()` into one array per dimension.
+     *
+     * @tparam Real the element type, `double` unless given explicitly
+     * @param[in] in the matrix, `rows * cols` long
+     * @param[in] rows the number of rows (points)
+     * @param[in] cols the number of columns (dimensions)
+     * @param[out] out the transposed matrix, `rows * cols` long
+     */
+    template <typename Real = double>
+    auto transpose(std::span<const std::type_identity_t<Real>> in, std::size_t rows,
+                   std::size_t cols, std::span<std::type_identity_t<Real>> out) -> void {
+        for (std::size_t r0 = 0; r0 < rows; r0 += TRANSPOSE_BLOCK) {
+            const auto r1 = std::min(rows, r0 + TRANSPOSE_BLOCK);
+            for (std::size_t c = 0; c < cols; ++c) {
+                auto* column = out.data() + c * rows;
+                for (auto r = r0; r < r1; ++r) {
+                    column[r] = in[r * cols + c];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Copy points from array-of-structs to structure-of-arrays layout
+     *
+     * Cache-blocked like `transpose()`.
+     *
+     * @tparam Real the coordinate type, `double` unless given explicitly
+     * @param[in] in the points
+     * @param[out] out one span per coordinate, each `in.size()` long
+     */
+    template <std::size_t N, typename Real = double>
+    auto to_soa(std::span<const std::array<std::type_identity_t<Real>, N>> in,
+                SoaSpan<N, std::type_identity_t<Real>> out) -> void {
+        for (std::size_t i0 = 0; i0 < in.size(); i0 += TRANSPOSE_BLOCK) {
+            const auto i1 = std::min(in.size(), i0 + TRANSPOSE_BLOCK);
+            for (std::size_t k = 0; k < N; ++k) {
+                for (auto i = i0; i < i1; ++i) {
+                    out[k][i] = in[i][k];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Copy points from structure-of-arrays to array-of-structs layout
+     *
+     * Cache-blocked like `transpose()`.
+     *
+     * @tparam Real the coordinate type, `double` unless given explicitly
+     * @param[in] in one span per coordinate, each `out.size()` long
+     * @param[out] out the points
+     */
+    template <std::size_t N, typename Real = double>
+    auto to_aos(SoaSpan<N, std::type_identity_t<Real>> in,
+                std::span<std::array<std::type_identity_t<Real>, N>> out) -> void {
+        for (std::size_t i0 = 0; i0 < out.size(); i0 += TRANSPOSE_BLOCK) {
+            const auto i1 = std::min(out.size(), i0 + TRANSPOSE_BLOCK);
+            for (std::size_t k = 0; k < N; ++k) {
+                for (auto i = i0; i < i1; ++i) {
+                    out[i][k] = in[k][i];
+                }
+            }
+        }
+    }
+
+}  // namespace ldsgen
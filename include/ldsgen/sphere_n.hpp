@@ -4,9 +4,15 @@
  *  @brief N-dimensional sphere sequence generators (Sphere3, SphereN, SphereWrapper).
  */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <mutex>
 #include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include "lds.hpp"
@@ -45,16 +51,178 @@ namespace ldsgen {
     double simple_interp(double x_value, std::span<const double> x_points,
                          std::span<const double> y_points);
 
+    /**
+     * @brief Shared table-lookup of the mapping function for n
+     *
+     * The tables sample the function at `LDSGEN_TP_POINTS` (300) evenly
+     * spaced angles in [0, pi]. Those of n <= `LDSGEN_TP_BAKED` (64) are
+     * computed at compile time; both macros can be defined when building
+     * the library. A larger table is built once, on first use (from the one
+     * of n - 2), and never changes or moves afterwards; later calls with
+     * n < 256 read it through an atomic pointer without taking a lock. So
+     * generators can keep the returned span for their whole lifetime.
+     *
+     * @param[in] n the dimension parameter
+     * @return std::span<const double> the table-lookup values
+     */
+    std::span<const double> tp_table(unsigned int n);
+
     /**
      * @brief Calculate the table-lookup of the mapping function for n
      *
-     * Calculates the table-lookup of the mapping function for n.
+     * Returns a copy of `tp_table(n)`.
      *
      * @param[in] n the dimension parameter
      * @return std::vector<double> the table-lookup values
      */
     std::vector<double> get_tp(unsigned int n);
 
+    /**
+     * @brief Constant-time inverse of the table of the mapping function for n
+     *
+     * `lookup(t)` equals `simple_interp(t, tp_table(n), tp_table(0))` bit
+     * for bit, without the binary search: the range of the table is cut
+     * into `BUCKETS` equal cells of t, each of which records the interval
+     * of the table its lower end falls in, so the lookup is one multiply
+     * and index, a short forward scan (usually no step at all) and the
+     * same lerp. (For n >= 8 rounding makes a few entries next to the poles
+     * dip by an ulp; where t crosses the table more than once there, the
+     * lookup takes the first crossing, the binary search any of them.)
+     *
+     * The interpolated angle is off by up to about 1e-4 (1e-5 away from
+     * the poles). `refined(t)` follows it with two Newton steps on the
+     * exact mapping function, to within a few ulp away from the poles.
+     *
+     * Instances are shared through `tp_lookup()`.
+     */
+    class TpLookup {
+      public:
+        static constexpr std::size_t BUCKETS = 1024;
+
+        /**
+         * @brief Construct the lookup of a table
+         *
+         * @param[in] n the dimension parameter
+         * @param[in] tp tp_table(n), which must outlive the lookup
+         * @param[in] x tp_table(0), likewise
+         */
+        constexpr TpLookup(unsigned int n, std::span<const double> tp, std::span<const double> x)
+            : tp_(tp),
+              x_(x),
+              cells_(static_cast<double>(BUCKETS) / (tp.back() - tp.front())),
+              first_{},
+              n_(n) {
+            // first_[b] is the last entry whose cell, computed as interval()
+            // does, lies below b: as the cells grow with t, that entry is <=
+            // any t of cell b, so the scan from there cannot overshoot.
+            std::size_t lo = 0;
+            for (std::size_t b = 0; b < BUCKETS; ++b) {
+                while (lo + 1 < tp.size() && this->cell(tp[lo + 1]) < b) {
+                    ++lo;
+                }
+                this->first_[b] = static_cast<std::uint16_t>(lo);
+            }
+        }
+
+        /**
+         * @brief The interpolated inverse of the mapping function
+         *
+         * @param[in] t a value of the mapping function
+         * @return double the angle xi in [0, pi] with tp(xi) = t
+         */
+        [[nodiscard]] auto operator()(double t) const -> double;
+
+        /**
+         * @brief The inverse of the mapping function, refined by Newton's method
+         *
+         * Several times as slow as `operator()`; the cost of each step grows
+         * with n, by one term of the recurrence of the table per two.
+         *
+         * @param[in] t a value of the mapping function
+         * @return double the angle xi in [0, pi] with tp(xi) = t
+         */
+        [[nodiscard]] auto refined(double t) const -> double;
+
+      private:
+        // the index of the last entry of tp_ <= t, for tp_.front() < t < tp_.back()
+        [[nodiscard]] constexpr auto cell(double t) const -> std::size_t {
+            return std::min(static_cast<std::size_t>((t - this->tp_.front()) * this->cells_),
+                            BUCKETS - 1);
+        }
+
+        [[nodiscard]] auto interval(double t) const -> std::size_t {
+            std::size_t lo = this->first_[this->cell(t)];
+            while (this->tp_[lo + 1] <= t) {
+                ++lo;
+            }
+            return lo;
+        }
+
+        std::span<const double> tp_;
+        std::span<const double> x_;
+        double cells_;  ///< BUCKETS per unit of t
+        std::array<std::uint16_t, BUCKETS> first_;
+        unsigned int n_;
+    };
+
+    /**
+     * @brief Shared `TpLookup` of the mapping function for n
+     *
+     * Built along with `tp_table(n)`, at compile time for n <= `LDSGEN_TP_BAKED`,
+     * and kept as long.
+     *
+     * @param[in] n the dimension parameter
+     * @return const TpLookup& the lookup of tp_table(n)
+     */
+    const TpLookup& tp_lookup(unsigned int n);
+
+    /**
+     * @brief (cos, sin) of the polar angle of one level of the sphere generators
+     *
+     * Maps the vdc value to t = t0 + range * vdc_value, inverts the mapping
+     * function there with `lookup` (or `lookup.refined()`, if `refine`) and
+     * returns `polar_sincos()` of the angle. Shared by `Sphere3`, `SphereN`
+     * and `SphereNT`; defined in sphere_n.cpp, which is compiled without FP
+     * contraction, so that code built with FMA enabled cannot round the
+     * points of `SphereNT` differently from those of `SphereN`.
+     *
+     * @param[in] lookup tp_lookup(n) of the level
+     * @param[in] refine whether to refine the angle by Newton's method
+     * @param[in] t0 tp_table(n).front(), or 0 for the level of `Sphere3`
+     * @param[in] range the span of tp_table(n), or pi/2 for the level of `Sphere3`
+     * @param[in] vdc_value the value of the van der Corput engine of the level
+     * @return std::array<double, 2>
+     */
+    auto level_sincos(const TpLookup& lookup, bool refine, double t0, double range,
+                      double vdc_value) -> std::array<double, 2>;
+
+    /**
+     * @brief The point of the 2-sphere at an index, by `Sphere::map_at()`
+     *
+     * The innermost level of `SphereN` and `SphereNT`; defined in sphere_n.cpp
+     * for the same reason as `level_sincos()`.
+     *
+     * @param[in] polar the engine of the polar coordinate
+     * @param[in] circle the engine of the circle
+     * @param[in] index the index in the sequence
+     * @return std::array<double, 3>
+     */
+    auto sphere2_at(const RadicalInverse& polar, const RadicalInverse& circle,
+                    unsigned long index) -> std::array<double, 3>;
+
+    /**
+     * @brief (cos, sin) of a polar angle, as the sphere generators compute it
+     *
+     * Goes through `sincos_turns()`, so that `at()` and the batch `fill()`,
+     * which uses `sincos_run()`, agree bit for bit.
+     *
+     * @param[in] xi the angle in radians
+     * @return std::array<double, 2>
+     */
+    inline auto polar_sincos(double xi) -> std::array<double, 2> {
+        return sincos_turns(xi / TWO_PI);
+    }
+
     /**
      * @brief Base class for sphere generators
      *
@@ -64,6 +232,17 @@ namespace ldsgen {
       public:
         virtual ~SphereGen() = default;
 
+      protected:
+        // copyable and movable through the derived classes only, which
+        // keeps the generators values without slicing them
+        SphereGen() = default;
+        SphereGen(const SphereGen&) = default;
+        SphereGen(SphereGen&&) = default;
+        auto operator=(const SphereGen&) -> SphereGen& = default;
+        auto operator=(SphereGen&&) -> SphereGen& = default;
+
+      public:
+
         /**
          * @brief Generate the next point on the sphere
          *
@@ -73,6 +252,24 @@ namespace ldsgen {
          */
         virtual std::vector<double> pop() = 0;
 
+        /**
+         * @brief Write the next point on the sphere in place
+         *
+         * @param[out] out the coordinates, one per dimension
+         */
+        virtual void pop(std::span<double> out) = 0;
+
+        /**
+         * @brief Fill a buffer with the next points on the sphere
+         *
+         * The points are stored row-major, `out.size() / dimension` points
+         * of `dimension` coordinates each, and their indices are claimed at
+         * once: one virtual call per batch rather than per point.
+         *
+         * @param[out] out the buffer to fill
+         */
+        virtual void fill(std::span<double> out) = 0;
+
         /**
          * @brief Reset the state of the sphere generator
          *
@@ -87,6 +284,8 @@ namespace ldsgen {
      * @brief 3-Sphere sequence generator
      *
      * Generates points on a 3-sphere using a combination of Van der Corput and Sphere generators.
+     * Both advance in lockstep, so the state is a single index: `pop()`
+     * claims it with one atomic operation and computes the point with `at()`.
      */
     class Sphere3 : public SphereGen {
       public:
@@ -96,8 +295,9 @@ namespace ldsgen {
          * Constructs a 3-sphere sequence generator with the specified bases.
          *
          * @param[in] base span of uint64_t values representing the bases for the generators
+         * @param[in] refine whether to refine the polar angle with `TpLookup::refined()`
          */
-        explicit Sphere3(std::span<const unsigned long> base);
+        explicit Sphere3(std::span<const unsigned long> base, bool refine = false);
 
         /**
          * @brief Generate the next point on the 3-sphere
@@ -108,6 +308,41 @@ namespace ldsgen {
          */
         std::vector<double> pop() override;
 
+        /**
+         * @brief Write the next point on the 3-sphere in place
+         *
+         * Allocates nothing and takes no lock.
+         *
+         * @param[out] out the 4 coordinates
+         */
+        void pop(std::span<double> out) override;
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * @param[in] index the index in the sequence
+         * @param[out] out the 4 coordinates
+         */
+        void at(unsigned long index, std::span<double> out) const;
+
+        /**
+         * @brief Fill a buffer with the next points on the 3-sphere
+         *
+         * @param[out] out the buffer to fill, 4 coordinates per point
+         */
+        void fill(std::span<double> out) override;
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator. Works on blocks of
+         * `FILL_BLOCK` points like `SphereN::fill()`.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill, 4 coordinates per point
+         */
+        void fill(unsigned long start, std::span<double> out) const;
+
         /**
          * @brief Reset the state of the Sphere3 generator
          *
@@ -117,17 +352,35 @@ namespace ldsgen {
          */
         void reseed(unsigned long seed) override;
 
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return Sphere3
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> Sphere3 {
+            auto copy = *this;
+            copy.count_.store(start);
+            return copy;
+        }
+
       private:
-        VdCorput vdc_;
-        Sphere sphere2_;
-        mutable std::mutex mutex_;
+        AtomicCounter count_;
+        RadicalInverse vdc_;
+        RadicalInverse polar2_;   ///< the engines of the 2-sphere, mapped by `Sphere::map_at()`
+        RadicalInverse circle2_;  ///< (no counter of their own)
+        const TpLookup* f2_;      ///< tp_lookup(2)
+        bool refine_;
     };
 
     /**
      * @brief Wrapper class to make Sphere compatible with SphereGen interface
      *
      * Provides a wrapper around the Sphere class to make it compatible with the SphereGen
-     * interface.
+     * interface. It takes no lock: `pop()` and `fill()` claim their indices
+     * from the counter of `Sphere` with one atomic operation each.
      */
     class SphereWrapper : public SphereGen {
       public:
@@ -149,6 +402,20 @@ namespace ldsgen {
          */
         std::vector<double> pop() override;
 
+        /**
+         * @brief Write the next point on the sphere in place
+         *
+         * @param[out] out the 3 coordinates
+         */
+        void pop(std::span<double> out) override;
+
+        /**
+         * @brief Fill a buffer with the next points on the sphere
+         *
+         * @param[out] out the buffer to fill, 3 coordinates per point
+         */
+        void fill(std::span<double> out) override;
+
         /**
          * @brief Reset the state of the SphereWrapper generator
          *
@@ -160,13 +427,16 @@ namespace ldsgen {
 
       private:
         Sphere sphere_;
-        mutable std::mutex mutex_;
     };
 
     /**
      * @brief N-dimensional sphere sequence generator
      *
      * Generates points on an N-dimensional sphere using a recursive approach.
+     * The recursion is flattened: one level per dimension from n down to 3,
+     * then the 3-sphere mapping of `Sphere3`. All levels advance in
+     * lockstep, so the state is a single index, claimed by `pop()` with one
+     * atomic operation.
      */
     class SphereN : public SphereGen {
       public:
@@ -176,8 +446,9 @@ namespace ldsgen {
          * Constructs an N-dimensional sphere sequence generator with the specified bases.
          *
          * @param[in] base span of uint64_t values representing the bases for the generators
+         * @param[in] refine whether to refine the polar angles with `TpLookup::refined()`
          */
-        explicit SphereN(std::span<const unsigned long> base);
+        explicit SphereN(std::span<const unsigned long> base, bool refine = false);
 
         /**
          * @brief Generate the next point on the N-dimensional sphere
@@ -188,6 +459,50 @@ namespace ldsgen {
          */
         std::vector<double> pop() override;
 
+        /**
+         * @brief Write the next point on the N-dimensional sphere in place
+         *
+         * Allocates nothing and takes no lock.
+         *
+         * @param[out] out the coordinates, one more than the number of bases
+         */
+        void pop(std::span<double> out) override;
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * Walks the levels from the outermost in, writing the cosine of each
+         * level's angle scaled by the product of the sines of the levels
+         * above: one interpolation, sin/cos pair and two multiplications per
+         * dimension.
+         *
+         * @param[in] index the index in the sequence
+         * @param[out] out the coordinates, one more than the number of bases
+         */
+        void at(unsigned long index, std::span<double> out) const;
+
+        /**
+         * @brief Fill a buffer with the next points on the N-dimensional sphere
+         *
+         * @param[out] out the buffer to fill, row-major, one more coordinate
+         *                 per point than the number of bases
+         */
+        void fill(std::span<double> out) override;
+
+        /**
+         * @brief Fill a buffer with the points starting at a given index
+         *
+         * Does not advance the state of the generator. Works on blocks of
+         * `FILL_BLOCK` points, level by level: one `VdcOdometer::fill()`,
+         * one pass of table interpolation and one `sincos_run()` per level,
+         * whose results are multiplied into that level's column in place.
+         * The points equal those of `at()` bit for bit.
+         *
+         * @param[in] start the index of the first point
+         * @param[out] out the buffer to fill, as in `fill(out)`
+         */
+        void fill(unsigned long start, std::span<double> out) const;
+
         /**
          * @brief Reset the state of the SphereN generator
          *
@@ -197,11 +512,194 @@ namespace ldsgen {
          */
         void reseed(unsigned long seed) override;
 
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return SphereN
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> SphereN {
+            auto copy = *this;
+            copy.count_.store(start);
+            return copy;
+        }
+
       private:
-        VdCorput vdc_;
-        std::unique_ptr<SphereGen> s_gen_;
+        /// The mapping of the polar angle of one level n >= 3
+        struct Level {
+            RadicalInverse vdc;
+            const TpLookup* lookup;  ///< tp_lookup(n)
+            double t0;
+            double range;
+        };
+
+        AtomicCounter count_;
+        std::vector<Level> levels_;  ///< n, n - 1, ..., 3
+        RadicalInverse vdc3_;        ///< the level n = 2, as in Sphere3
+        RadicalInverse polar2_;      ///< the engines of the 2-sphere, as in Sphere3
+        RadicalInverse circle2_;
+        const TpLookup* f2_;  ///< tp_lookup(2)
         unsigned int n_;
+        bool refine_;
+    };
+
+    /**
+     * @brief The levels of `SphereNT<N, Refine>`, without an index of their own
+     *
+     * Level N maps the polar angle of dimension N and holds the levels below
+     * it by value, down to `SphereNTLevels<2, Refine>`, the two engines of
+     * `Sphere`. Only the `SphereNT` on top of the chain keeps a counter.
+     *
+     * @tparam N the dimension of the sphere of this level
+     * @tparam Refine as in `SphereNT`
+     */
+    template <unsigned int N, bool Refine> class SphereNTLevels {
+        RadicalInverse vdc_;
+        SphereNTLevels<N - 1, Refine> sub_;
+        const TpLookup* lookup_;  ///< tp_lookup(N - 1), which is the F2 of Sphere3 for N = 3
+        double t0_;
         double range_;
-        mutable std::mutex mutex_;
+
+      public:
+        /**
+         * @brief Construct the levels N, N - 1, ..., 2
+         *
+         * @param[in] base the N bases, in the order `SphereN` takes them
+         */
+        explicit SphereNTLevels(std::span<const unsigned long> base)
+            : vdc_(base[0]),
+              sub_(base.subspan(1)),
+              lookup_(&tp_lookup(N - 1)),
+              t0_(N == 3 ? 0.0 : tp_table(N - 1).front()),
+              range_(N == 3 ? HALF_PI : tp_table(N - 1).back() - t0_) {}
+
+        /**
+         * @brief Write the point at an index, scaled, to out[0], ..., out[N]
+         *
+         * @param[in] index the index in the sequence
+         * @param[in] scale the product of the sines of the levels above
+         * @param[out] out the N + 1 coordinates
+         */
+        void at_scaled(unsigned long index, double scale, double* out) const {
+            const auto unit = level_sincos(*lookup_, Refine, t0_, range_, vdc_.at(index));
+            out[N] = scale * unit[0];
+            sub_.at_scaled(index, scale * unit[1], out);
+        }
+    };
+
+    /// The innermost level of `SphereNT`: the 2-sphere, by `sphere2_at()`
+    template <bool Refine> class SphereNTLevels<2, Refine> {
+        RadicalInverse polar_;
+        RadicalInverse circle_;
+
+      public:
+        /**
+         * @brief Construct the level from the bases of `Sphere`
+         *
+         * @param[in] base the 2 bases
+         */
+        explicit SphereNTLevels(std::span<const unsigned long> base)
+            : polar_(base[0]), circle_(base[1]) {}
+
+        /**
+         * @brief Write the point at an index, scaled, to out[0], out[1], out[2]
+         *
+         * @param[in] index the index in the sequence
+         * @param[in] scale the product of the sines of the levels above
+         * @param[out] out the 3 coordinates
+         */
+        void at_scaled(unsigned long index, double scale, double* out) const {
+            const auto sphere2_point = sphere2_at(polar_, circle_, index);
+            out[0] = scale * sphere2_point[0];
+            out[1] = scale * sphere2_point[1];
+            out[2] = scale * sphere2_point[2];
+        }
+    };
+
+    /**
+     * @brief N-sphere sequence generator with the dimension fixed at compile time
+     *
+     * Produces the same points as `SphereN` over the same N bases, as
+     * `std::array<double, N + 1>`. The recursion over the levels is a chain
+     * of nested `SphereNTLevels`, down to the engines of `Sphere`, resolved
+     * at compile time: no heap, no virtual calls and no locks, and the whole
+     * chain of `at()` can be inlined. The state is one index, the only
+     * counter of the chain, claimed by `pop()` with a single atomic operation.
+     *
+     * @verbatim
+     *     auto sgen = SphereNT<5>(std::array{2UL, 3UL, 5UL, 7UL, 11UL});
+     *     auto point = sgen.pop();  // std::array<double, 6>
+     * @endverbatim
+     *
+     * @tparam N the dimension of the sphere, at least 3 (`Sphere` is N = 2)
+     * @tparam Refine whether to refine the polar angles with `TpLookup::refined()`,
+     *                as the `refine` argument of `SphereN`
+     */
+    template <unsigned int N, bool Refine = false> class SphereNT {
+        static_assert(N >= 3, "N must be at least 3 (use Sphere for N = 2)");
+
+        using Point = std::array<double, N + 1>;
+
+        AtomicCounter count_;
+        SphereNTLevels<N, Refine> levels_;
+
+        static auto checked_bases(std::span<const unsigned long> base)
+            -> std::span<const unsigned long> {
+            if (base.size() != N) {
+                throw std::invalid_argument("SphereNT<N> requires exactly N bases");
+            }
+            return base;
+        }
+
+      public:
+        /**
+         * @brief Construct a new SphereNT object
+         *
+         * @param[in] base the N bases, in the order `SphereN` takes them
+         * @throw std::invalid_argument if `base` does not hold exactly N bases
+         */
+        explicit SphereNT(std::span<const unsigned long> base) : levels_(checked_bases(base)) {}
+
+        /**
+         * @brief Generate the next point on the sphere
+         *
+         * @return Point the next point
+         */
+        auto pop() -> Point { return this->at(this->count_.fetch_add(1)); }
+
+        /**
+         * @brief Get the point at a given index without advancing state
+         *
+         * @param[in] index the index in the sequence
+         * @return Point the point at that index
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> Point {
+            Point result;
+            this->levels_.at_scaled(index, 1.0, result.data());
+            return result;
+        }
+
+        /**
+         * @brief Reset the state of the generator
+         *
+         * @param[in] seed the index of the next point
+         */
+        auto reseed(unsigned long seed) -> void { this->count_.store(seed); }
+
+        /**
+         * @brief Copy the generator, positioned at a given index
+         *
+         * As `BasicVdCorput::fork()`.
+         *
+         * @param[in] start the index of the first point the copy pops
+         * @return SphereNT
+         */
+        [[nodiscard]] auto fork(unsigned long start) const -> SphereNT {
+            auto copy = *this;
+            copy.count_.store(start);
+            return copy;
+        }
     };
 }  // namespace ldsgen
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+/** @file unit_roots.hpp
+ *  @brief Trigonometry-free points on the unit circle from tables of roots of unity.
+ */
+
+#include <array>   // for array
+#include <memory>  // for shared_ptr
+#include <span>    // for span
+#include <vector>  // for vector
+
+#include "fast_div.hpp"  // for FastDivider
+#include "lds.hpp"       // for RadicalInverse, BasicCircle, ...
+
+namespace ldsgen {
+
+    /**
+     * @brief Incremental engine for the points e^(2 pi i vdc(n)) of the unit circle
+     *
+     * The unit-circle counterpart of `VdcOdometer`. The angle 2 pi vdc(n) is
+     * the sum of `2 pi d_k / b^(k+1)` over the digits d_k of n, so the point
+     * is the product of one root of unity per digit. `partial[k]` holds the
+     * product for digits k and above; a step recomputes only the products of
+     * the digits that changed, one complex multiplication per point on
+     * average. Defined in unit_roots.cpp.
+     */
+    class UnitOdometer {
+        unsigned long base;
+        const std::array<double, 2>* roots;
+        unsigned int num_digits{0};
+        std::array<unsigned long, MAX_REVERSE_BITS> digits{};
+        std::array<std::array<double, 2>, MAX_REVERSE_BITS + 1> partial;
+
+      public:
+        /**
+         * @brief Construct a new UnitOdometer object
+         *
+         * @param[in] base the base of the digits
+         * @param[in] roots the table of `UnitRoots`
+         * @param[in] index the index the first `pop()` corresponds to
+         */
+        UnitOdometer(unsigned long base, const std::array<double, 2>* roots, unsigned long index);
+
+        /**
+         * @brief Advance to the next count and return its point
+         *
+         * @return std::array<double, 2> (cos, sin) of 2 pi times the next value
+         */
+        auto pop() -> std::array<double, 2>;
+
+        /**
+         * @brief Write the next `out.size()` points
+         *
+         * Equivalent to calling `pop()` for each element. Within a run over
+         * which only the lowest digit changes, each point is one complex
+         * multiplication of the unchanged product of the higher digits.
+         *
+         * @param[out] out the buffer to fill
+         */
+        auto fill(std::span<std::array<double, 2>> out) -> void;
+    };
+
+    /**
+     * @brief Radical inverse engine with a runtime base and unit-circle tables
+     *
+     * A `RadicalInverse` that is also a `UnitRootEngine`: it keeps the
+     * table of roots of unity `e^(2 pi i d / b^(k+1))` for every digit d and
+     * digit position k (64 positions in base 2, fewer in larger bases), and
+     * computes the point (cos, sin) of `2 * pi * at(index)` as their product.
+     * `Circle`, `Disk`, `Sphere` and `Sphere3Hopf` built on it
+     * (`TrigFreeCircle`, ...) call no trigonometric function at all.
+     *
+     * The table is built once per base and shared, read-only, by all the
+     * `UnitRoots` of that base and their copies (`fork()` of the generators
+     * does not copy it); it is freed with the last of them.
+     *
+     * Accuracy: the table entries are computed in long double and rounded
+     * (an error of at most 1.6e-16 each), and each complex multiplication
+     * adds at most 3.2e-16. A point is therefore within `5e-16 * D` of the
+     * exact one, D being the number of non-zero digits of index + 1: at most
+     * 30 in base 2 for the first 10^9 points, a bound of 1.5e-14. Zero digits
+     * are free and exact. `std::cos(vdc * TWO_PI)` is itself up to about
+     * 1e-15 off, as the angle is rounded. Where long double is no wider than
+     * double (MSVC, and AArch64 on Apple platforms), the rounding of the angle
+     * of an entry makes it off by up to 2.2e-15, and the bound is `2.5e-15 * D`
+     * instead, 7.5e-14 for the first 10^9 points in base 2.
+     *
+     * `unit_at(index)` and the odometer multiply the same factors in the same
+     * order, so `at()` and `fill()` of the generators agree bit for bit.
+     */
+    class UnitRoots {
+        RadicalInverse inverse;
+        unsigned long base;
+        FastDivider divider;
+        /// (*roots)[k * base + d] = (cos, sin)(2 pi d / base^(k+1)), shared by the base
+        std::shared_ptr<const std::vector<std::array<double, 2>>> roots;
+
+      public:
+        /**
+         * @brief Construct a new UnitRoots object
+         *
+         * Defined in unit_roots.cpp.
+         *
+         * @param[in] base the base of the Van der Corput sequence
+         */
+        explicit UnitRoots(unsigned long base);
+
+        /**
+         * @brief Get the value at a given index
+         *
+         * @param[in] index the index in the sequence (index 0 maps to count 1)
+         * @return double
+         */
+        [[nodiscard]] auto at(unsigned long index) const -> double {
+            return this->inverse.at(index);
+        }
+
+        /**
+         * @brief Create an incremental engine positioned at a given index
+         *
+         * @param[in] index the index in the sequence
+         * @return VdcOdometer
+         */
+        [[nodiscard]] auto odometer(unsigned long index) const -> VdcOdometer {
+            return this->inverse.odometer(index);
+        }
+
+        /**
+         * @brief Get the point of the unit circle at a given index
+         *
+         * Defined in unit_roots.cpp.
+         *
+         * @param[in] index the index in the sequence (index 0 maps to count 1)
+         * @return std::array<double, 2> (cos, sin) of `2 * pi * at(index)`
+         */
+        [[nodiscard]] auto unit_at(unsigned long index) const -> std::array<double, 2>;
+
+        /**
+         * @brief Create an incremental unit-circle engine positioned at a given index
+         *
+         * @param[in] index the index in the sequence
+         * @return UnitOdometer
+         */
+        [[nodiscard]] auto unit_odometer(unsigned long index) const -> UnitOdometer {
+            return UnitOdometer(this->base, this->roots->data(), index);
+        }
+
+        /**
+         * @brief Get the base
+         *
+         * @return unsigned long
+         */
+        [[nodiscard]] auto get_base() const -> unsigned long { return this->base; }
+    };
+
+    /// Circle sequence generator without trigonometric calls
+    using TrigFreeCircle = BasicCircle<UnitRoots>;
+
+    /// Disk sequence generator without trigonometric calls
+    using TrigFreeDisk = BasicDisk<UnitRoots, RadicalInverse>;
+
+    /// Sphere sequence generator without trigonometric calls
+    using TrigFreeSphere = BasicSphere<RadicalInverse, UnitRoots>;
+
+    /// S(3) sequence generator by Hopf fibration without trigonometric calls
+    using TrigFreeSphere3Hopf = BasicSphere3Hopf<UnitRoots, UnitRoots, RadicalInverse>;
+
+}  // namespace ldsgen
@@ -0,0 +1,45 @@
+#pragma once
+
+/** @file fdlibm_kernel.hpp
+ *  @brief fdlibm's sin and cos polynomials, internal to the library.
+ *
+ *  sincos_kernel.cpp evaluates them at run time and sphere_n.cpp at compile
+ *  time, for the tables of the mapping function; one copy keeps the two in
+ *  agreement.
+ */
+
+namespace ldsgen {
+
+    namespace fdlibm {
+        // minimax coefficients of sin and cos on [-pi/4, pi/4]
+        inline constexpr double S1 = -1.66666666666666324348e-01;
+        inline constexpr double S2 = 8.33333333332248946124e-03;
+        inline constexpr double S3 = -1.98412698298579493134e-04;
+        inline constexpr double S4 = 2.75573137070700676789e-06;
+        inline constexpr double S5 = -2.50507602534068634195e-08;
+        inline constexpr double S6 = 1.58969099521155010221e-10;
+        inline constexpr double C1 = 4.16666666666666019037e-02;
+        inline constexpr double C2 = -1.38888888888741095749e-03;
+        inline constexpr double C3 = 2.48015872894767294178e-05;
+        inline constexpr double C4 = -2.75573143513906633035e-07;
+        inline constexpr double C5 = 2.08757232129817482790e-09;
+        inline constexpr double C6 = -1.13596475577881948265e-11;
+
+        /// sin x for |x| <= pi/4, within 1 ulp
+        constexpr auto kernel_sin(double x) -> double {
+            const double z = x * x;
+            return x + (z * x) * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+        }
+
+        /// cos x for |x| <= pi/4, within 1 ulp
+        constexpr auto kernel_cos(double x) -> double {
+            const double z = x * x;
+            const double hz = 0.5 * z;
+            const double w = 1.0 - hz;
+            return w
+                   + (((1.0 - w) - hz)
+                      + z * (z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))))));
+        }
+    }  // namespace fdlibm
+
+}  // namespace ldsgen
@@ -1,10 +1,12 @@
+#include "ldsgen/lds.hpp"
+
 #include <array>
 
 namespace ldsgen {
 
     /// @brief First 1000 prime numbers
     /// @details Used as lookup table for selecting bases in low-discrepancy sequences
-    constexpr std::array<unsigned long, 1000> PRIME_TABLE = {
+    const std::array<unsigned long, 1000> PRIME_TABLE = {
         2,    3,    5,    7,    11,   13,   17,   19,   23,   29,   31,   37,   41,   43,   47,
         53,   59,   61,   67,   71,   73,   79,   83,   89,   97,   101,  103,  107,  109,  113,
         127,  131,  137,  139,  149,  151,  157,  163,  167,  173,  179,  181,  191,  193,  197,
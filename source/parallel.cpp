@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ldsgen/parallel.hpp"
+
+#if defined(__linux__)
+#    include <sched.h>
+#endif
+
+namespace ldsgen {
+
+    namespace {
+
+        // A worker's share of the tasks, [begin, end), packed into one word:
+        // begin in the high half, end in the low half.
+        struct alignas(CACHE_LINE_SIZE) TaskQueue {
+            std::atomic<std::uint64_t> range{0};
+        };
+
+        auto pack(std::uint64_t begin, std::uint64_t end) -> std::uint64_t {
+            return (begin << 32U) | end;
+        }
+
+        // The owner takes the first task of its share.
+        auto take(TaskQueue& queue, std::uint64_t& task) -> bool {
+            auto range = queue.range.load(std::memory_order_acquire);
+            while (true) {
+                const auto begin = range >> 32U;
+                const auto end = range & 0xFFFFFFFFU;
+                if (begin >= end) {
+                    return false;
+                }
+                if (queue.range.compare_exchange_weak(range, pack(begin + 1, end),
+                                                      std::memory_order_acq_rel)) {
+                    task = begin;
+                    return true;
+                }
+            }
+        }
+
+        // A thief takes the back half (at least one) of the tasks left in a share.
+        auto steal(TaskQueue& queue, std::uint64_t& stolen_begin, std::uint64_t& stolen_end)
+            -> bool {
+            auto range = queue.range.load(std::memory_order_acquire);
+            while (true) {
+                const auto begin = range >> 32U;
+                const auto end = range & 0xFFFFFFFFU;
+                if (begin >= end) {
+                    return false;
+                }
+                const auto split = end - (end - begin + 1) / 2;
+                if (queue.range.compare_exchange_weak(range, pack(begin, split),
+                                                      std::memory_order_acq_rel)) {
+                    stolen_begin = split;
+                    stolen_end = end;
+                    return true;
+                }
+            }
+        }
+
+        // Keeps the first exception thrown by the body of a loop, from any thread
+        struct FirstError {
+            std::exception_ptr error;
+            std::mutex mutex;
+
+            auto capture() -> void {
+                const std::scoped_lock lock(this->mutex);
+                if (!this->error) {
+                    this->error = std::current_exception();
+                }
+            }
+
+            auto rethrow() const -> void {
+                if (this->error) {
+                    std::rethrow_exception(this->error);
+                }
+            }
+        };
+
+        // The CPUs the process may run on, in order; empty where threads cannot be pinned
+        auto allowed_cpus() -> std::vector<int> {
+            auto cpus = std::vector<int>{};
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &set)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            return cpus;
+        }
+
+        // Pins the calling thread to one CPU; a no-op where that is not supported
+        auto pin_to_cpu([[maybe_unused]] int cpu) -> void {
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            ::sched_setaffinity(0, sizeof(set), &set);  // best effort: unpinned on failure
+#endif
+        }
+
+        // Set on the threads of the pool, whose nested parallel_for() calls run serially
+        thread_local bool on_pool_thread = false;
+
+        // The worker threads of parallel_for(), one per CPU the process may run
+        // on, worker i pinned to the i-th of them (on Linux). Created on first
+        // use and kept until the program exits; runs one job at a time, which
+        // the calling thread waits for.
+        class WorkerPool {
+          public:
+            using Job = std::function<void(std::size_t)>;
+
+            static auto instance() -> WorkerPool& {
+                static WorkerPool pool;
+                return pool;
+            }
+
+            WorkerPool(const WorkerPool&) = delete;
+            auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+
+            ~WorkerPool() { this->stop(); }
+
+            [[nodiscard]] auto size() const -> std::size_t { return this->threads.size(); }
+
+            // Calls job(self) on workers 0, ..., num_workers - 1 and waits for all of them.
+            // The job must not throw.
+            auto run(std::size_t num_workers, const Job& job) -> void {
+                const std::scoped_lock dispatch(this->dispatch_mutex);
+                std::unique_lock lock(this->mutex);
+                this->job = &job;
+                this->num_workers = num_workers;
+                this->pending = num_workers;
+                ++this->generation;
+                this->wake.notify_all();
+                this->done.wait(lock, [this] { return this->pending == 0; });
+                this->job = nullptr;
+            }
+
+          private:
+            WorkerPool() : cpus(allowed_cpus()) {
+                const auto num_threads
+                    = this->cpus.empty() ? std::max(std::thread::hardware_concurrency(), 1U)
+                                         : this->cpus.size();
+                this->threads.reserve(num_threads);
+                try {
+                    for (std::size_t i = 0; i < num_threads; ++i) {
+                        this->threads.emplace_back([this, i] { this->loop(i); });
+                    }
+                } catch (...) {
+                    // a joinable std::thread would terminate
+                    this->stop();
+                    throw;
+                }
+            }
+
+            auto loop(std::size_t self) -> void {
+                on_pool_thread = true;
+                if (!this->cpus.empty()) {
+                    pin_to_cpu(this->cpus[self]);
+                }
+                std::uint64_t seen = 0;
+                while (true) {
+                    const Job* current = nullptr;
+                    {
+                        std::unique_lock lock(this->mutex);
+                        this->wake.wait(lock, [&] {
+                            return this->stopping || this->generation != seen;
+                        });
+                        if (this->stopping) {
+                            return;
+                        }
+                        seen = this->generation;
+                        if (self >= this->num_workers) {
+                            continue;
+                        }
+                        current = this->job;
+                    }
+                    (*current)(self);
+                    const std::scoped_lock lock(this->mutex);
+                    if (--this->pending == 0) {
+                        this->done.notify_one();
+                    }
+                }
+            }
+
+            auto stop() -> void {
+                {
+                    const std::scoped_lock lock(this->mutex);
+                    this->stopping = true;
+                }
+                this->wake.notify_all();
+                for (auto& thread : this->threads) {
+                    thread.join();
+                }
+            }
+
+            std::mutex dispatch_mutex;  ///< held by run(), so jobs of other threads wait their turn
+            std::mutex mutex;           ///< guards the members below
+            std::condition_variable wake;
+            std::condition_variable done;
+            const Job* job{nullptr};
+            std::size_t num_workers{0};
+            std::size_t pending{0};
+            std::uint64_t generation{0};
+            bool stopping{false};
+            std::vector<int> cpus;  ///< the CPU of each worker, if pinned
+            std::vector<std::thread> threads;
+        };
+
+    }  // namespace
+
+    auto parallel_for(std::size_t num_items, std::size_t grain, unsigned int num_threads,
+                      const std::function<void(std::size_t, std::size_t)>& body) -> void {
+        if (num_items == 0) {
+            return;
+        }
+        if (num_threads == 0) {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        // the task indices must fit the 32-bit halves of a share
+        const auto task_size
+            = std::max({grain, std::size_t(1), num_items / (num_threads * TASKS_PER_THREAD),
+                        num_items / std::size_t(0xFFFFFFFFU) + 1});
+        const auto num_tasks = (num_items + task_size - 1) / task_size;
+        num_threads = static_cast<unsigned int>(std::min<std::size_t>(num_threads, num_tasks));
+        if (num_threads == 1 || on_pool_thread) {
+            body(0, num_items);
+            return;
+        }
+        auto& pool = WorkerPool::instance();
+        num_threads = static_cast<unsigned int>(std::min<std::size_t>(num_threads, pool.size()));
+
+        auto queues = std::vector<TaskQueue>(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            queues[i].range.store(pack(num_tasks * i / num_threads,
+                                       num_tasks * (i + 1) / num_threads),
+                                  std::memory_order_relaxed);
+        }
+        auto error = FirstError{};
+
+        const auto worker = [&](std::size_t self) {
+            try {
+                std::uint64_t task = 0;
+                while (true) {
+                    while (take(queues[self], task)) {
+                        const auto begin = task * task_size;
+                        body(begin, std::min(begin + task_size, num_items));
+                    }
+                    // own share is empty: steal from the others, starting at the next one
+                    bool stolen = false;
+                    for (std::size_t k = 1; k < num_threads && !stolen; ++k) {
+                        std::uint64_t stolen_begin = 0;
+                        std::uint64_t stolen_end = 0;
+                        if (steal(queues[(self + k) % num_threads], stolen_begin, stolen_end)) {
+                            queues[self].range.store(pack(stolen_begin, stolen_end),
+                                                     std::memory_order_release);
+                            stolen = true;
+                        }
+                    }
+                    if (!stolen) {
+                        return;
+                    }
+                }
+            } catch (...) {
+                error.capture();
+            }
+        };
+
+        pool.run(num_threads, worker);
+        error.rethrow();
+    }
+
+    auto parallel_for_static(std::size_t num_items, std::size_t grain, unsigned int num_threads,
+                             const std::function<void(std::size_t, std::size_t)>& body) -> void {
+        if (num_items == 0) {
+            return;
+        }
+        if (on_pool_thread) {
+            body(0, num_items);
+            return;
+        }
+        if (num_threads == 0) {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        auto& pool = WorkerPool::instance();
+        grain = std::max(grain, std::size_t(1));
+        const auto num_grains = (num_items + grain - 1) / grain;
+        const auto num_shares = std::min({std::size_t(num_threads), num_grains, pool.size()});
+        auto error = FirstError{};
+
+        pool.run(num_shares, [&](std::size_t self) {
+            try {
+                const auto begin = std::min(num_grains * self / num_shares * grain, num_items);
+                const auto end = std::min(num_grains * (self + 1) / num_shares * grain, num_items);
+                if (begin < end) {
+                    body(begin, end);
+                }
+            } catch (...) {
+                error.capture();
+            }
+        });
+        error.rethrow();
+    }
+
+}  // namespace ldsgen
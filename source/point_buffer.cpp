@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#include "ldsgen/point_buffer.hpp"
+
+#if defined(__linux__)
+#    include <sys/mman.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    define LDSGEN_STREAM_STORES 1
+#    include <emmintrin.h>
+#endif
+
+namespace ldsgen {
+
+    auto allocate_points(std::size_t bytes, bool huge_pages) -> void* {
+        if (bytes == 0) {
+            return nullptr;
+        }
+#if defined(__linux__)
+        if (huge_pages) {
+            // over-map by one huge page and trim, so the region starts on a huge page boundary
+            const auto length = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+            auto* raw = ::mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+            const auto aligned = (addr + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+            if (aligned != addr) {
+                ::munmap(raw, aligned - addr);
+            }
+            ::munmap(reinterpret_cast<void*>(aligned + length), addr + HUGE_PAGE_SIZE - aligned);
+            auto* ptr = reinterpret_cast<void*>(aligned);
+#    ifdef MADV_HUGEPAGE
+            ::madvise(ptr, length, MADV_HUGEPAGE);  // a hint: failure leaves normal pages
+#    endif
+            return ptr;
+        }
+#endif
+        (void)huge_pages;
+        return ::operator new(bytes, std::align_val_t{BUFFER_ALIGNMENT});
+    }
+
+    auto deallocate_points(void* ptr, std::size_t bytes, bool huge_pages) -> void {
+        if (ptr == nullptr) {
+            return;
+        }
+#if defined(__linux__)
+        if (huge_pages) {
+            ::munmap(ptr, (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+            return;
+        }
+#endif
+        (void)bytes;
+        (void)huge_pages;
+        ::operator delete(ptr, std::align_val_t{BUFFER_ALIGNMENT});
+    }
+
+    template <typename Real>
+    auto stream_copy(std::span<const std::type_identity_t<Real>> src, std::span<Real> dst)
+        -> void {
+#ifdef LDSGEN_STREAM_STORES
+        constexpr std::size_t LANES = 16 / sizeof(Real);
+        const auto n = src.size();
+        std::size_t i = 0;
+        // streaming stores need 16-byte aligned destinations
+        for (; i < n && (reinterpret_cast<std::uintptr_t>(dst.data() + i) % 16) != 0; ++i) {
+            dst[i] = src[i];
+        }
+        for (; i + LANES <= n; i += LANES) {
+            if constexpr (std::is_same_v<Real, double>) {
+                _mm_stream_pd(dst.data() + i, _mm_loadu_pd(src.data() + i));
+            } else {
+                _mm_stream_ps(dst.data() + i, _mm_loadu_ps(src.data() + i));
+            }
+        }
+        for (; i < n; ++i) {
+            dst[i] = src[i];
+        }
+        _mm_sfence();
+#else
+        std::memcpy(dst.data(), src.data(), src.size() * sizeof(Real));
+#endif
+    }
+
+    template auto stream_copy<double>(std::span<const double> src, std::span<double> dst)
+        -> void;
+    template auto stream_copy<float>(std::span<const float> src, std::span<float> dst) -> void;
+
+}  // namespace ldsgen
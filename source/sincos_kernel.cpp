@@ -0,0 +1,250 @@
+// Multiplies and adds must stay separate (no FMA) so that every lane rounds
+// exactly like sincos_turns(), which at() uses.
+#if defined(__clang__)
+#    pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#    pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include "fdlibm_kernel.hpp"
+#include "ldsgen/lds.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#    define LDSGEN_X86_DISPATCH 1
+#    include <immintrin.h>
+#endif
+
+namespace ldsgen {
+
+    namespace {
+
+        // the vector kernels below evaluate fdlibm::kernel_sin/kernel_cos lane by lane
+        using fdlibm::C1, fdlibm::C2, fdlibm::C3, fdlibm::C4, fdlibm::C5, fdlibm::C6;
+        using fdlibm::S1, fdlibm::S2, fdlibm::S3, fdlibm::S4, fdlibm::S5, fdlibm::S6;
+
+#ifdef LDSGEN_X86_DISPATCH
+        // the masked AVX-512 forms with all lanes set avoid GCC's false
+        // maybe-uninitialized warning on the unmasked ones' undefined source
+        constexpr __mmask8 ALL_LANES = 0xFF;
+#endif
+
+        using SincosKernel = void (*)(const double*, std::array<double, 2>*, std::size_t);
+        using SqrtKernel = void (*)(const double*, double*, std::size_t);
+
+        // The angle is split as quarter * pi/2 + x with |x| <= pi/4. The
+        // subtraction of the nearest quarter turn is exact, so only the final
+        // product with TWO_PI rounds, on a small argument.
+
+        auto sincos_scalar(const double* turns, std::array<double, 2>* out, std::size_t n)
+            -> void {
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto quarter = std::nearbyint(turns[i] * 4.0);
+                const auto x = (turns[i] - quarter * 0.25) * TWO_PI;
+                const auto sin_x = fdlibm::kernel_sin(x);
+                const auto cos_x = fdlibm::kernel_cos(x);
+                const auto quadrant = quarter - 4.0 * std::floor(quarter * 0.25);
+                const auto odd = quadrant == 1.0 || quadrant == 3.0;
+                auto cos_t = odd ? sin_x : cos_x;
+                auto sin_t = odd ? cos_x : sin_x;
+                if (quadrant == 1.0 || quadrant == 2.0) {
+                    cos_t = -cos_t;
+                }
+                if (quadrant >= 2.0) {
+                    sin_t = -sin_t;
+                }
+                out[i] = {cos_t, sin_t};
+            }
+        }
+
+        auto sqrt_scalar(const double* in, double* out, std::size_t n) -> void {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = std::sqrt(in[i]);
+            }
+        }
+
+#ifdef LDSGEN_X86_DISPATCH
+        __attribute__((target("avx2"))) auto sincos_avx2(const double* turns,
+                                                         std::array<double, 2>* out,
+                                                         std::size_t n) -> void {
+            const auto sign = _mm256_set1_pd(-0.0);
+            const auto one = _mm256_set1_pd(1.0);
+            const auto two = _mm256_set1_pd(2.0);
+            const auto three = _mm256_set1_pd(3.0);
+            const auto half = _mm256_set1_pd(0.5);
+            const auto quarter_turn = _mm256_set1_pd(0.25);
+            const auto four = _mm256_set1_pd(4.0);
+            const auto two_pi = _mm256_set1_pd(TWO_PI);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const auto t = _mm256_loadu_pd(turns + i);
+                const auto quarter = _mm256_round_pd(_mm256_mul_pd(t, four),
+                                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                const auto x = _mm256_mul_pd(
+                    _mm256_sub_pd(t, _mm256_mul_pd(quarter, quarter_turn)), two_pi);
+                const auto z = _mm256_mul_pd(x, x);
+                auto poly = _mm256_add_pd(_mm256_set1_pd(S5), _mm256_mul_pd(z, _mm256_set1_pd(S6)));
+                poly = _mm256_add_pd(_mm256_set1_pd(S4), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(S3), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(S2), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(S1), _mm256_mul_pd(z, poly));
+                const auto sin_x = _mm256_add_pd(x, _mm256_mul_pd(_mm256_mul_pd(z, x), poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(C5), _mm256_mul_pd(z, _mm256_set1_pd(C6)));
+                poly = _mm256_add_pd(_mm256_set1_pd(C4), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(C3), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(C2), _mm256_mul_pd(z, poly));
+                poly = _mm256_add_pd(_mm256_set1_pd(C1), _mm256_mul_pd(z, poly));
+                const auto hz = _mm256_mul_pd(half, z);
+                const auto w = _mm256_sub_pd(one, hz);
+                const auto tail = _mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(one, w), hz),
+                                                _mm256_mul_pd(z, _mm256_mul_pd(z, poly)));
+                const auto cos_x = _mm256_add_pd(w, tail);
+                const auto quadrant = _mm256_sub_pd(
+                    quarter, _mm256_mul_pd(four, _mm256_floor_pd(_mm256_mul_pd(quarter, quarter_turn))));
+                const auto odd = _mm256_or_pd(_mm256_cmp_pd(quadrant, one, _CMP_EQ_OQ),
+                                              _mm256_cmp_pd(quadrant, three, _CMP_EQ_OQ));
+                const auto neg_cos = _mm256_or_pd(_mm256_cmp_pd(quadrant, one, _CMP_EQ_OQ),
+                                                  _mm256_cmp_pd(quadrant, two, _CMP_EQ_OQ));
+                const auto neg_sin = _mm256_cmp_pd(quadrant, two, _CMP_GE_OQ);
+                const auto cos_t = _mm256_xor_pd(_mm256_blendv_pd(cos_x, sin_x, odd),
+                                                 _mm256_and_pd(neg_cos, sign));
+                const auto sin_t = _mm256_xor_pd(_mm256_blendv_pd(sin_x, cos_x, odd),
+                                                 _mm256_and_pd(neg_sin, sign));
+                // interleave into (cos, sin) pairs
+                const auto even_pairs = _mm256_unpacklo_pd(cos_t, sin_t);
+                const auto odd_pairs = _mm256_unpackhi_pd(cos_t, sin_t);
+                auto* dst = reinterpret_cast<double*>(out + i);
+                _mm256_storeu_pd(dst, _mm256_permute2f128_pd(even_pairs, odd_pairs, 0x20));
+                _mm256_storeu_pd(dst + 4, _mm256_permute2f128_pd(even_pairs, odd_pairs, 0x31));
+            }
+            sincos_scalar(turns + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) auto sqrt_avx2(const double* in, double* out,
+                                                       std::size_t n) -> void {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+            }
+            sqrt_scalar(in + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx512f"))) auto sincos_avx512(const double* turns,
+                                                              std::array<double, 2>* out,
+                                                              std::size_t n) -> void {
+            const auto one = _mm512_set1_pd(1.0);
+            const auto two = _mm512_set1_pd(2.0);
+            const auto three = _mm512_set1_pd(3.0);
+            const auto half = _mm512_set1_pd(0.5);
+            const auto quarter_turn = _mm512_set1_pd(0.25);
+            const auto four = _mm512_set1_pd(4.0);
+            const auto two_pi = _mm512_set1_pd(TWO_PI);
+            const auto minus_one = _mm512_set1_pd(-1.0);
+            const auto even_index = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+            const auto odd_index = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto t = _mm512_loadu_pd(turns + i);
+                const auto scaled = _mm512_mul_pd(t, four);
+                const auto quarter = _mm512_mask_roundscale_pd(scaled, ALL_LANES, scaled,
+                                                               _MM_FROUND_TO_NEAREST_INT);
+                const auto x = _mm512_mul_pd(
+                    _mm512_sub_pd(t, _mm512_mul_pd(quarter, quarter_turn)), two_pi);
+                const auto z = _mm512_mul_pd(x, x);
+                auto poly = _mm512_add_pd(_mm512_set1_pd(S5), _mm512_mul_pd(z, _mm512_set1_pd(S6)));
+                poly = _mm512_add_pd(_mm512_set1_pd(S4), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(S3), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(S2), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(S1), _mm512_mul_pd(z, poly));
+                const auto sin_x = _mm512_add_pd(x, _mm512_mul_pd(_mm512_mul_pd(z, x), poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(C5), _mm512_mul_pd(z, _mm512_set1_pd(C6)));
+                poly = _mm512_add_pd(_mm512_set1_pd(C4), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(C3), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(C2), _mm512_mul_pd(z, poly));
+                poly = _mm512_add_pd(_mm512_set1_pd(C1), _mm512_mul_pd(z, poly));
+                const auto hz = _mm512_mul_pd(half, z);
+                const auto w = _mm512_sub_pd(one, hz);
+                const auto tail = _mm512_add_pd(_mm512_sub_pd(_mm512_sub_pd(one, w), hz),
+                                                _mm512_mul_pd(z, _mm512_mul_pd(z, poly)));
+                const auto cos_x = _mm512_add_pd(w, tail);
+                const auto turns_down = _mm512_mul_pd(quarter, quarter_turn);
+                const auto quadrant = _mm512_sub_pd(
+                    quarter, _mm512_mul_pd(four, _mm512_mask_roundscale_pd(
+                                                     turns_down, ALL_LANES, turns_down,
+                                                     _MM_FROUND_TO_NEG_INF)));
+                const auto is_one = _mm512_cmp_pd_mask(quadrant, one, _CMP_EQ_OQ);
+                const auto odd = is_one | _mm512_cmp_pd_mask(quadrant, three, _CMP_EQ_OQ);
+                const auto neg_cos = is_one | _mm512_cmp_pd_mask(quadrant, two, _CMP_EQ_OQ);
+                const auto neg_sin = _mm512_cmp_pd_mask(quadrant, two, _CMP_GE_OQ);
+                auto cos_t = _mm512_mask_blend_pd(odd, cos_x, sin_x);
+                auto sin_t = _mm512_mask_blend_pd(odd, sin_x, cos_x);
+                // times -1 rather than 0 - v, which would turn -0.0 into +0.0
+                cos_t = _mm512_mask_mul_pd(cos_t, neg_cos, cos_t, minus_one);
+                sin_t = _mm512_mask_mul_pd(sin_t, neg_sin, sin_t, minus_one);
+                // interleave into (cos, sin) pairs
+                auto* dst = reinterpret_cast<double*>(out + i);
+                _mm512_storeu_pd(dst, _mm512_permutex2var_pd(cos_t, even_index, sin_t));
+                _mm512_storeu_pd(dst + 8, _mm512_permutex2var_pd(cos_t, odd_index, sin_t));
+            }
+            sincos_avx2(turns + i, out + i, n - i);
+        }
+
+        __attribute__((target("avx512f"))) auto sqrt_avx512(const double* in, double* out,
+                                                            std::size_t n) -> void {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto value = _mm512_loadu_pd(in + i);
+                _mm512_storeu_pd(out + i, _mm512_mask_sqrt_pd(value, ALL_LANES, value));
+            }
+            sqrt_avx2(in + i, out + i, n - i);
+        }
+#endif
+
+        struct Kernels {
+            SincosKernel sincos;
+            SqrtKernel sqrt;
+            const char* name;
+        };
+
+        auto select_kernels() -> Kernels {
+#ifdef LDSGEN_X86_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return {sincos_avx512, sqrt_avx512, "avx512f"};
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return {sincos_avx2, sqrt_avx2, "avx2"};
+            }
+#endif
+            return {sincos_scalar, sqrt_scalar, "scalar"};
+        }
+
+        auto kernels() -> const Kernels& {
+            static const Kernels selected = select_kernels();
+            return selected;
+        }
+
+    }  // namespace
+
+    auto sincos_turns(double turns) -> std::array<double, 2> {
+        std::array<double, 2> point;
+        sincos_scalar(&turns, &point, 1);
+        return point;
+    }
+
+    auto sincos_run(std::span<const double> turns, std::span<std::array<double, 2>> out)
+        -> void {
+        kernels().sincos(turns.data(), out.data(), turns.size());
+    }
+
+    auto sqrt_run(std::span<const double> in, std::span<double> out) -> void {
+        kernels().sqrt(in.data(), out.data(), in.size());
+    }
+
+    auto sincos_kernel_name() -> const char* { return kernels().name; }
+
+}  // namespace ldsgen
@@ -1,13 +1,26 @@
 #include "ldsgen/sphere_n.hpp"
 
 #include <algorithm>
-#include <cmath>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "fdlibm_kernel.hpp"
+
+// The number of samples of the tables of the mapping function, and the
+// largest n whose table is computed at compile time
+#ifndef LDSGEN_TP_POINTS
+#    define LDSGEN_TP_POINTS 300
+#endif
+#ifndef LDSGEN_TP_BAKED
+#    define LDSGEN_TP_BAKED 64
+#endif
+
 namespace ldsgen {
 
     std::vector<double> linspace(double start, double stop, unsigned int num) {
@@ -50,195 +63,440 @@ namespace ldsgen {
 
     // Precomputed tables (similar to Python version)
     namespace {
-        const std::vector<double> X = linspace(0.0, PI, 300);
+        constexpr std::size_t TP_POINTS = LDSGEN_TP_POINTS;
+        constexpr unsigned int TP_BAKED = LDSGEN_TP_BAKED;
+        static_assert(TP_POINTS >= 2 && TP_POINTS <= 65536,
+                      "TpLookup stores table intervals as 16-bit indices");
+        static_assert(TP_BAKED >= 1, "tp(0) and tp(1) are always baked");
+
+        using Table = std::array<double, TP_POINTS>;
+
+        // (cos x, sin x) for x in [0, pi], at compile time. pi/2 is split as
+        // PIO2_HI + PIO2_LO, with the 33 bits of PIO2_HI making quarter *
+        // PIO2_HI and its subtraction exact (Cody and Waite).
+        constexpr auto table_sincos(double x) -> std::array<double, 2> {
+            constexpr double PIO2_HI = 1.57079632673412561417e+00;
+            constexpr double PIO2_LO = 6.07710050650619224932e-11;
+            const auto quarter = static_cast<int>(x / HALF_PI + 0.5);
+            const double r = (x - quarter * PIO2_HI) - quarter * PIO2_LO;
+            const double sin_r = fdlibm::kernel_sin(r);
+            const double cos_r = fdlibm::kernel_cos(r);
+            switch (quarter) {
+                case 0:
+                    return {cos_r, sin_r};
+                case 1:
+                    return {-sin_r, cos_r};
+                default:
+                    return {-cos_r, -sin_r};
+            }
+        }
 
-        std::vector<double> compute_neg_cosine() {
-            std::vector<double> result;
-            result.reserve(X.size());
-            for (double x : X) {
-                result.emplace_back(-std::cos(x));
+        // linspace(0.0, PI, TP_POINTS)
+        constexpr auto make_x() -> Table {
+            Table result{};
+            const double step = (PI - 0.0) / static_cast<double>(TP_POINTS - 1);
+            for (std::size_t i = 0; i < TP_POINTS; ++i) {
+                result[i] = 0.0 + (static_cast<double>(i) * step);
             }
             return result;
         }
 
-        std::vector<double> compute_sine() {
-            std::vector<double> result;
-            result.reserve(X.size());
-            for (double x : X) {
-                result.emplace_back(std::sin(x));
+        constexpr Table X = make_x();
+
+        constexpr auto make_neg_cosine() -> Table {
+            Table result{};
+            for (std::size_t i = 0; i < TP_POINTS; ++i) {
+                result[i] = -table_sincos(X[i])[0];
             }
             return result;
         }
 
-        std::vector<double> compute_f2(const std::vector<double>& neg_cosine,
-                                       const std::vector<double>& sine) {
-            std::vector<double> result;
-            result.reserve(X.size());
-            for (unsigned int i = 0; i < X.size(); ++i) {
-                result.emplace_back((X[i] + neg_cosine[i] * sine[i]) / 2.0);
+        constexpr auto make_sine() -> Table {
+            Table result{};
+            for (std::size_t i = 0; i < TP_POINTS; ++i) {
+                result[i] = table_sincos(X[i])[1];
             }
             return result;
         }
 
-        const std::vector<double> NEG_COSINE = compute_neg_cosine();
-        const std::vector<double> SINE = compute_sine();
-        const std::vector<double> F2 = compute_f2(NEG_COSINE, SINE);
-    }  // namespace
-
-    // Iterative helper for get_tp — avoids deep recursion and vector copies
-    static std::vector<double> get_tp_recursive(unsigned int n) {
-        if (n == 0) {
-            return X;
+        constexpr Table NEG_COSINE = make_neg_cosine();
+        constexpr Table SINE = make_sine();
+
+        // tp(n) from tp(n - 2) and sin^(n - 1); the power then becomes
+        // sin^(n + 1), for tp(n + 2)
+        constexpr void next_tp(unsigned int n, std::span<const double> prev2,
+                               std::span<double> power, std::span<double> out) {
+            for (std::size_t j = 0; j < TP_POINTS; ++j) {
+                out[j] = (static_cast<double>(n - 1) * prev2[j] + NEG_COSINE[j] * power[j])
+                         / static_cast<double>(n);
+                power[j] *= SINE[j] * SINE[j];
+            }
         }
-        if (n == 1) {
-            return NEG_COSINE;
+
+        struct BakedTables {
+            std::array<Table, TP_BAKED + 1> tp;
+            std::array<Table, 2> power;  ///< sin^(n - 1) for the next even and odd n
+        };
+
+        // tp(0), ..., tp(TP_BAKED), each from the one of n - 2
+        constexpr auto make_baked() -> BakedTables {
+            BakedTables result{};
+            result.tp[0] = X;
+            result.tp[1] = NEG_COSINE;
+            for (std::size_t j = 0; j < TP_POINTS; ++j) {
+                result.power[0][j] = SINE[j];
+                result.power[1][j] = SINE[j] * SINE[j];
+            }
+            for (unsigned int n = 2; n <= TP_BAKED; ++n) {
+                next_tp(n, result.tp[n - 2], result.power[n % 2], result.tp[n]);
+            }
+            return result;
         }
 
-        // Bottom-up iteration: compute tp[2..n] using tp[i-2] and tp[i-1]
-        std::vector<double> prev2 = X;           // tp[0]
-        std::vector<double> prev1 = NEG_COSINE;  // tp[1]
-        std::vector<double> current;
-        current.reserve(X.size());
+        constexpr BakedTables BAKED = make_baked();
+
+        constexpr auto BAKED_LOOKUPS = []<std::size_t... N>(std::index_sequence<N...>) {
+            return std::array{TpLookup(static_cast<unsigned int>(N), BAKED.tp[N], X)...};
+        }(std::make_index_sequence<TP_BAKED + 1>{});
+
+        // Newton steps of TpLookup::refined(): the interpolated angle is off
+        // by up to about 1e-4 for large n, which two steps square away
+        constexpr int NEWTON_STEPS = 2;
+
+        // The table of one dimension above TP_BAKED and its lookup, which refers to it
+        struct TpEntry {
+            std::vector<double> table;
+            std::vector<double> power;  ///< sin^(n + 1), for tp(n + 2)
+            TpLookup lookup;
+
+            TpEntry(unsigned int n, std::vector<double> values, std::vector<double> next_power)
+                : table(std::move(values)), power(std::move(next_power)), lookup(n, table, X) {}
+        };
+
+        // Entries of the dimensions below TP_SLOTS are published here once
+        // built; the entries of larger ones are looked up under tp_mutex.
+        constexpr unsigned int TP_SLOTS = 256;
+        std::array<std::atomic<const TpEntry*>, TP_SLOTS> tp_slots{};
+        std::mutex tp_mutex;
+        // owns every entry; entries are never removed, so pointers stay valid
+        std::unordered_map<unsigned int, std::unique_ptr<const TpEntry>> tp_tables;
+
+        // tp(n) from tp(n - 2), building that first if needed; tp_mutex is held
+        auto tp_locked(unsigned int n) -> const TpEntry* {
+            auto& entry = tp_tables[n];  // references survive rehashing
+            if (entry) {
+                return entry.get();
+            }
+            std::span<const double> prev2;
+            std::vector<double> power;
+            if (n - 2 <= TP_BAKED) {
+                prev2 = BAKED.tp[n - 2];
+                const auto& baked_power = BAKED.power[n % 2];
+                power.assign(baked_power.begin(), baked_power.end());
+            } else {
+                const auto* prev = tp_locked(n - 2);
+                prev2 = prev->table;
+                power = prev->power;
+            }
+            std::vector<double> current(TP_POINTS);
+            next_tp(n, prev2, power, current);
+            entry = std::make_unique<const TpEntry>(n, std::move(current), std::move(power));
+            return entry.get();
+        }
 
-        for (unsigned int i = 2; i <= n; ++i) {
-            current.clear();
-            for (std::size_t j = 0; j < X.size(); ++j) {
-                double value = (static_cast<double>(i - 1) * prev2[j]
-                                + NEG_COSINE[j] * std::pow(SINE[j], i - 1))
-                               / static_cast<double>(i);
-                current.emplace_back(value);
+        auto tp_entry(unsigned int n) -> const TpEntry& {
+            if (n < TP_SLOTS) {
+                if (const auto* entry = tp_slots[n].load(std::memory_order_acquire)) {
+                    return *entry;
+                }
             }
-            if (i < n) {
-                prev2 = std::move(prev1);
-                prev1 = std::move(current);
-                current.reserve(X.size());
+            std::scoped_lock lock(tp_mutex);
+            const auto* entry = tp_locked(n);
+            if (n < TP_SLOTS) {
+                tp_slots[n].store(entry, std::memory_order_release);
             }
+            return *entry;
         }
-        return current;
+    }  // namespace
+
+    std::span<const double> tp_table(unsigned int n) {
+        if (n <= TP_BAKED) {
+            return BAKED.tp[n];
+        }
+        return tp_entry(n).table;
+    }
+
+    const TpLookup& tp_lookup(unsigned int n) {
+        if (n <= TP_BAKED) {
+            return BAKED_LOOKUPS[n];
+        }
+        return tp_entry(n).lookup;
     }
 
     std::vector<double> get_tp(unsigned int n) {
-        static std::unordered_map<int, std::vector<double>> tp_cache;
-        static std::mutex tp_cache_mutex;
+        auto table = tp_table(n);
+        return {table.begin(), table.end()};
+    }
 
-        std::scoped_lock lock(tp_cache_mutex);
+    auto TpLookup::operator()(double t) const -> double {
+        if (t <= this->tp_.front()) {
+            return this->x_.front();
+        }
+        if (t >= this->tp_.back()) {
+            return this->x_.back();
+        }
+        const auto lo = this->interval(t);
+        double u = (t - this->tp_[lo]) / (this->tp_[lo + 1] - this->tp_[lo]);
+        return this->x_[lo] + u * (this->x_[lo + 1] - this->x_[lo]);
+    }
 
-        auto it = tp_cache.find(n);
-        if (it != tp_cache.end()) {
-            return it->second;
+    auto TpLookup::refined(double t) const -> double {
+        if (t <= this->tp_.front()) {
+            return this->x_.front();
         }
+        if (t >= this->tp_.back()) {
+            return this->x_.back();
+        }
+        const auto lo = this->interval(t);
+        double u = (t - this->tp_[lo]) / (this->tp_[lo + 1] - this->tp_[lo]);
+        double xi = this->x_[lo] + u * (this->x_[lo + 1] - this->x_[lo]);
+        for (int step = 0; step < NEWTON_STEPS; ++step) {
+            // tp(n) at xi, by the recurrence of the tables, and its derivative sin^n(xi)
+            const auto [cosine, sine] = sincos_turns(xi / TWO_PI);
+            const bool odd = this->n_ % 2 != 0;
+            double value = odd ? -cosine : xi;
+            double slope = odd ? sine : 1.0;
+            double power = odd ? sine * sine : sine;  // sin^(k - 1)
+            for (unsigned int k = odd ? 3 : 2; k <= this->n_; k += 2) {
+                value = (static_cast<double>(k - 1) * value - cosine * power)
+                        / static_cast<double>(k);
+                power *= sine * sine;
+                slope *= sine * sine;
+            }
+            if (!(slope > 0.0)) {
+                break;
+            }
+            // the root lies in the interval of the table, which keeps the
+            // step bounded where the slope vanishes at the poles
+            xi = std::clamp(xi - (value - t) / slope, this->x_[lo], this->x_[lo + 1]);
+        }
+        return xi;
+    }
 
-        auto result = get_tp_recursive(n);
-        tp_cache[n] = result;
-        return result;
+    auto level_sincos(const TpLookup& lookup, bool refine, double t0, double range,
+                      double vdc_value) -> std::array<double, 2> {
+        const double ti = t0 + range * vdc_value;  // map to [t0, tm-1]
+        return polar_sincos(refine ? lookup.refined(ti) : lookup(ti));
     }
 
-    Sphere3::Sphere3(std::span<const unsigned long> base)
-        : vdc_(base[0]), sphere2_(base[1], base[2]) {
-        if (base.size() < 3) {
-            throw std::invalid_argument("Sphere3 requires at least 3 bases");
-        }
+    auto sphere2_at(const RadicalInverse& polar, const RadicalInverse& circle,
+                    unsigned long index) -> std::array<double, 3> {
+        return Sphere::map_at(polar, circle, index);
     }
 
-    std::vector<double> Sphere3::pop() {
-        std::scoped_lock lock(mutex_);
-        double ti = HALF_PI * vdc_.pop();  // map to [t0, tm-1]
-        double xi = simple_interp(ti, F2, X);
-        double cosxi = std::cos(xi);
-        double sinxi = std::sin(xi);
+    namespace {
+        // the mapping of Sphere3 (level n = 2), with all coordinates scaled by `scale`
+        void sphere3_point(const TpLookup& f2, bool refine, double vdc_value,
+                           const std::array<double, 3>& sphere2_point, double scale,
+                           std::span<double> out) {
+            const auto unit = level_sincos(f2, refine, 0.0, HALF_PI, vdc_value);
+            out[3] = scale * unit[0];
+            scale *= unit[1];
+            out[0] = scale * sphere2_point[0];
+            out[1] = scale * sphere2_point[1];
+            out[2] = scale * sphere2_point[2];
+        }
 
-        auto sphere2_point = sphere2_.pop();
-        std::vector<double> result;
-        result.reserve(4);
-        result.emplace_back(sinxi * sphere2_point[0]);
-        result.emplace_back(sinxi * sphere2_point[1]);
-        result.emplace_back(sinxi * sphere2_point[2]);
-        result.emplace_back(cosxi);
+        // Scratch space of the batch kernels for one block of points
+        struct LevelBlock {
+            std::array<double, FILL_BLOCK> ti;     // mapped vdc values, then angles in turns
+            std::array<double, FILL_BLOCK> scale;  // products of the sines of the levels above
+            std::array<std::array<double, 2>, FILL_BLOCK> units;
+            std::array<std::array<double, 3>, FILL_BLOCK> sphere2;
+        };
+
+        // One level over the first `num` rows (of `dim` coordinates) of `rows`:
+        // column `col` gets scale * cos(xi), and scale picks up sin(xi)
+        void level_block(const TpLookup& lookup, bool refine, LevelBlock& block,
+                         std::size_t num, double* rows, std::size_t dim, std::size_t col) {
+            if (refine) {
+                for (std::size_t i = 0; i < num; ++i) {
+                    block.ti[i] = lookup.refined(block.ti[i]) / TWO_PI;
+                }
+            } else {
+                for (std::size_t i = 0; i < num; ++i) {
+                    block.ti[i] = lookup(block.ti[i]) / TWO_PI;
+                }
+            }
+            sincos_run(std::span(block.ti).first(num), std::span(block.units).first(num));
+            for (std::size_t i = 0; i < num; ++i) {
+                rows[i * dim + col] = block.scale[i] * block.units[i][0];
+                block.scale[i] *= block.units[i][1];
+            }
+        }
 
+        // sphere3_point() over the first `num` rows, column by column
+        void sphere3_block(const TpLookup& f2, bool refine, VdcOdometer& odo,
+                           const RadicalInverse& polar2, const RadicalInverse& circle2,
+                           unsigned long start, LevelBlock& block, std::size_t num, double* rows,
+                           std::size_t dim) {
+            odo.fill(std::span(block.ti).first(num));
+            for (std::size_t i = 0; i < num; ++i) {
+                block.ti[i] = HALF_PI * block.ti[i];
+            }
+            level_block(f2, refine, block, num, rows, dim, 3);
+            Sphere::map_fill(polar2, circle2, start, std::span(block.sphere2).first(num));
+            for (std::size_t i = 0; i < num; ++i) {
+                rows[i * dim] = block.scale[i] * block.sphere2[i][0];
+                rows[i * dim + 1] = block.scale[i] * block.sphere2[i][1];
+                rows[i * dim + 2] = block.scale[i] * block.sphere2[i][2];
+            }
+        }
+
+        // `base`, once it is known to hold the at least 3 bases of Sphere3 and SphereN;
+        // called in the first member initializer, before anything reads it
+        auto checked_bases(std::span<const unsigned long> base, const char* message)
+            -> std::span<const unsigned long> {
+            if (base.size() < 3) {
+                throw std::invalid_argument(message);
+            }
+            return base;
+        }
+    }  // namespace
+
+    Sphere3::Sphere3(std::span<const unsigned long> base, bool refine)
+        : vdc_(checked_bases(base, "Sphere3 requires at least 3 bases")[0]),
+          polar2_(base[1]),
+          circle2_(base[2]),
+          f2_(&tp_lookup(2)),
+          refine_(refine) {}
+
+    std::vector<double> Sphere3::pop() {
+        std::vector<double> result(4);
+        pop(result);
         return result;
     }
 
-    void Sphere3::reseed(unsigned long seed) {
-        std::scoped_lock lock(mutex_);
-        vdc_.reseed(seed);
-        sphere2_.reseed(seed);
+    void Sphere3::pop(std::span<double> out) { at(count_.fetch_add(1), out); }
+
+    void Sphere3::at(unsigned long index, std::span<double> out) const {
+        sphere3_point(*f2_, refine_, vdc_.at(index), sphere2_at(polar2_, circle2_, index), 1.0,
+                      out);
     }
 
+    void Sphere3::fill(std::span<double> out) { fill(count_.fetch_add(out.size() / 4), out); }
+
+    void Sphere3::fill(unsigned long start, std::span<double> out) const {
+        const auto num_points = out.size() / 4;
+        auto odo = vdc_.odometer(start);
+        LevelBlock block;
+        for (std::size_t k = 0; k < num_points; k += FILL_BLOCK) {
+            const auto num = std::min(num_points - k, FILL_BLOCK);
+            block.scale.fill(1.0);
+            sphere3_block(*f2_, refine_, odo, polar2_, circle2_, start + k, block, num,
+                          out.data() + k * 4, 4);
+        }
+    }
+
+    void Sphere3::reseed(unsigned long seed) { count_.store(seed); }
+
     // SphereWrapper implementation
     SphereWrapper::SphereWrapper(std::span<const unsigned long> base) : sphere_(base[0], base[1]) {}
 
     std::vector<double> SphereWrapper::pop() {
-        std::scoped_lock lock(mutex_);
         auto arr = sphere_.pop();
         std::vector<double> result(arr.begin(), arr.end());
         return result;
     }
 
-    void SphereWrapper::reseed(unsigned long seed) {
-        std::scoped_lock lock(mutex_);
-        sphere_.reseed(seed);
+    void SphereWrapper::pop(std::span<double> out) {
+        std::ranges::copy(sphere_.pop(), out.begin());
     }
 
-    SphereN::SphereN(std::span<const unsigned long> base)
-        : vdc_(base[0]), n_(static_cast<unsigned int>(base.size() - 1)) {
-        if (n_ < 2) {
-            throw std::invalid_argument("SphereN requires at least 3 bases (n >= 2)");
-        }
-
-        if (n_ == 2) {
-            // Create a SphereWrapper object
-            std::vector<unsigned long> sphere_base = {base[1], base[2]};
-            s_gen_ = std::make_unique<SphereWrapper>(sphere_base);
-        } else {
-            std::vector<unsigned long> sub_base(base.begin() + 1, base.end());
-            s_gen_ = std::make_unique<SphereN>(sub_base);
+    void SphereWrapper::fill(std::span<double> out) {
+        const auto num_points = out.size() / 3;
+        const auto start = sphere_.claim(num_points);
+        std::array<std::array<double, 3>, FILL_BLOCK> block;
+        for (std::size_t k = 0; k < num_points; k += FILL_BLOCK) {
+            const auto num = std::min(num_points - k, FILL_BLOCK);
+            sphere_.fill(start + k, std::span(block).first(num));
+            for (std::size_t i = 0; i < num; ++i) {
+                std::ranges::copy(block[i], out.begin() + static_cast<std::ptrdiff_t>((k + i) * 3));
+            }
         }
-
-        auto tp = get_tp(n_);
-        range_ = tp.back() - tp.front();
     }
-    std::vector<double> SphereN::pop() {
-        std::scoped_lock lock(mutex_);
-        if (n_ == 2) {
-            double ti = HALF_PI * vdc_.pop();  // map to [t0, tm-1]
-            double xi = simple_interp(ti, F2, X);
-            double cosxi = std::cos(xi);
-            double sinxi = std::sin(xi);
-
-            auto sub_point = s_gen_->pop();
-            std::vector<double> result;
-            result.reserve(sub_point.size() + 1);
 
-            for (double s : sub_point) {
-                result.emplace_back(sinxi * s);
-            }
-            result.emplace_back(cosxi);
+    void SphereWrapper::reseed(unsigned long seed) {
+        sphere_.reseed(seed);
+    }
 
-            return result;
+    SphereN::SphereN(std::span<const unsigned long> base, bool refine)
+        : vdc3_(checked_bases(base, "SphereN requires at least 3 bases (n >= 2)")[base.size() - 3]),
+          polar2_(base[base.size() - 2]),
+          circle2_(base[base.size() - 1]),
+          f2_(&tp_lookup(2)),
+          n_(static_cast<unsigned int>(base.size() - 1)),
+          refine_(refine) {
+        levels_.reserve(n_ - 2);
+        for (unsigned int n = n_; n >= 3; --n) {
+            auto tp = tp_table(n);
+            levels_.push_back(
+                {RadicalInverse(base[n_ - n]), &tp_lookup(n), tp.front(), tp.back() - tp.front()});
         }
+    }
 
-        double vd = vdc_.pop();
-        auto tp = get_tp(n_);
-        double ti = tp.front() + range_ * vd;  // map to [t0, tm-1]
-        double xi = simple_interp(ti, tp, X);
-        double sinphi = std::sin(xi);
+    std::vector<double> SphereN::pop() {
+        std::vector<double> result(n_ + 2);
+        pop(result);
+        return result;
+    }
 
-        auto sub_point = s_gen_->pop();
-        std::vector<double> result;
-        result.reserve(sub_point.size() + 1);
+    void SphereN::pop(std::span<double> out) { at(count_.fetch_add(1), out); }
 
-        for (double s : sub_point) {
-            result.emplace_back(s * sinphi);
+    void SphereN::at(unsigned long index, std::span<double> out) const {
+        double scale = 1.0;  // the product of the sines of the levels above
+        auto last = out.size();
+        for (const auto& level : levels_) {
+            const auto unit
+                = level_sincos(*level.lookup, refine_, level.t0, level.range, level.vdc.at(index));
+            out[--last] = scale * unit[0];
+            scale *= unit[1];
         }
-        result.emplace_back(std::cos(xi));
+        sphere3_point(*f2_, refine_, vdc3_.at(index), sphere2_at(polar2_, circle2_, index),
+                      scale, out);
+    }
 
-        return result;
+    void SphereN::fill(std::span<double> out) {
+        fill(count_.fetch_add(out.size() / (n_ + 2)), out);
     }
 
-    void SphereN::reseed(unsigned long seed) {
-        std::scoped_lock lock(mutex_);
-        vdc_.reseed(seed);
-        s_gen_->reseed(seed);
+    void SphereN::fill(unsigned long start, std::span<double> out) const {
+        const std::size_t dim = n_ + 2;
+        const auto num_points = out.size() / dim;
+        std::vector<VdcOdometer> odos;
+        odos.reserve(levels_.size());
+        for (const auto& level : levels_) {
+            odos.emplace_back(level.vdc.odometer(start));
+        }
+        auto odo3 = vdc3_.odometer(start);
+        LevelBlock block;
+        for (std::size_t k = 0; k < num_points; k += FILL_BLOCK) {
+            const auto num = std::min(num_points - k, FILL_BLOCK);
+            auto* rows = out.data() + k * dim;
+            block.scale.fill(1.0);
+            for (std::size_t j = 0; j < levels_.size(); ++j) {
+                const auto& level = levels_[j];
+                odos[j].fill(std::span(block.ti).first(num));
+                for (std::size_t i = 0; i < num; ++i) {
+                    block.ti[i] = level.t0 + level.range * block.ti[i];
+                }
+                level_block(*level.lookup, refine_, block, num, rows, dim, dim - 1 - j);
+            }
+            sphere3_block(*f2_, refine_, odo3, polar2_, circle2_, start + k, block, num, rows,
+                          dim);
+        }
     }
 
+    void SphereN::reseed(unsigned long seed) { count_.store(seed); }
+
 }  // namespace ldsgen
\ No newline at end of file
@@ -0,0 +1,131 @@
+// Multiplies and adds must stay separate (no FMA) so that UnitRoots::unit_at()
+// and UnitOdometer round exactly alike.
+#if defined(__clang__)
+#    pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#    pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "ldsgen/unit_roots.hpp"
+
+namespace ldsgen {
+
+    namespace {
+        using RootTable = std::vector<std::array<double, 2>>;
+
+        auto make_roots(const unsigned long base) -> RootTable {
+            unsigned int num_positions = 0;
+            for (auto rest = std::numeric_limits<unsigned long>::max(); rest != 0; rest /= base) {
+                ++num_positions;
+            }
+            RootTable roots;
+            roots.reserve(std::size_t(num_positions) * base);
+            auto denom = static_cast<long double>(base);
+            for (unsigned int k = 0; k < num_positions; ++k, denom *= base) {
+                for (unsigned long d = 0; d < base; ++d) {
+                    const auto theta = 2 * std::numbers::pi_v<long double> * d / denom;
+                    roots.push_back({static_cast<double>(std::cos(theta)),
+                                     static_cast<double>(std::sin(theta))});
+                }
+            }
+            return roots;
+        }
+
+        // The table of a base, built by the first UnitRoots of that base and
+        // freed with the last one
+        auto shared_roots(const unsigned long base) -> std::shared_ptr<const RootTable> {
+            static std::mutex roots_mutex;
+            static std::unordered_map<unsigned long, std::weak_ptr<const RootTable>> roots_tables;
+            const std::scoped_lock lock(roots_mutex);
+            auto& entry = roots_tables[base];
+            auto roots = entry.lock();
+            if (!roots) {
+                roots = std::make_shared<const RootTable>(make_roots(base));
+                entry = roots;
+            }
+            return roots;
+        }
+    }  // namespace
+
+    UnitRoots::UnitRoots(const unsigned long base)
+        : inverse{base}, base{base}, divider{base}, roots{shared_roots(base)} {}
+
+    auto UnitRoots::unit_at(unsigned long index) const -> std::array<double, 2> {
+        std::array<unsigned long, MAX_REVERSE_BITS> digits{};
+        unsigned int num_digits = 0;
+        for (auto count = index + 1; count != 0;) {
+            const auto quotient = count / this->divider;
+            digits[num_digits++] = count - quotient * this->base;
+            count = quotient;
+        }
+        auto point = std::array<double, 2>{1.0, 0.0};
+        for (auto k = num_digits; k-- > 0;) {
+            point = unit_mul(point, (*this->roots)[k * this->base + digits[k]]);
+        }
+        return point;
+    }
+
+    UnitOdometer::UnitOdometer(const unsigned long base, const std::array<double, 2>* roots,
+                               unsigned long index)
+        : base{base}, roots{roots} {
+        this->partial.fill({1.0, 0.0});
+        while (index != 0) {
+            this->digits[this->num_digits++] = index % base;
+            index /= base;
+        }
+        for (auto k = this->num_digits; k-- > 0;) {
+            this->partial[k]
+                = unit_mul(this->partial[k + 1], roots[k * base + this->digits[k]]);
+        }
+    }
+
+    auto UnitOdometer::pop() -> std::array<double, 2> {
+        unsigned int idx = 0;
+        while (idx < this->num_digits && this->digits[idx] == this->base - 1) {
+            this->digits[idx++] = 0;
+        }
+        if (idx == this->num_digits) {
+            ++this->num_digits;
+        }
+        ++this->digits[idx];
+        for (auto k = idx + 1; k-- > 0;) {
+            this->partial[k] = unit_mul(this->partial[k + 1],
+                                        this->roots[k * this->base + this->digits[k]]);
+        }
+        return this->partial[0];
+    }
+
+    auto UnitOdometer::fill(std::span<std::array<double, 2>> out) -> void {
+        if (this->num_digits == 0) {
+            this->num_digits = 1;  // count 0 as a single zero digit
+        }
+        while (!out.empty()) {
+            const auto first = this->digits[0] + 1;
+            if (first == this->base) {
+                out.front() = this->pop();
+                out = out.subspan(1);
+                continue;
+            }
+            const auto run = std::min<std::size_t>(out.size(), this->base - first);
+            const auto high = this->partial[1];
+            for (std::size_t j = 0; j < run; ++j) {
+                out[j] = unit_mul(high, this->roots[first + j]);
+            }
+            this->digits[0] += run;
+            this->partial[0] = out[run - 1];
+            out = out.subspan(run);
+        }
+    }
+
+}  // namespace ldsgen
@@ -0,0 +1,436 @@
+// Multiplies and adds must stay separate (no FMA) so that every lane rounds
+// exactly like VdcOdometer::pop() and VdCorput::at(), which are defined here
+// for the same reason. GCC would otherwise fuse the vector intrinsics, which
+// it implements as plain vector arithmetic.
+#if defined(__clang__)
+#    pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#    pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "ldsgen/lds.hpp"
+#include "ldsgen/lds_n.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#    define LDSGEN_X86_DISPATCH 1
+#    include <immintrin.h>
+#endif
+
+namespace ldsgen {
+
+    namespace {
+
+        using RunKernel = void (*)(const double*, const double*, std::size_t, double*, std::size_t);
+        using RampKernel
+            = void (*)(double, unsigned long, const double*, std::size_t, double*, std::size_t);
+        using PointKernel = void (*)(const HaltonLanes&, std::size_t, unsigned long, double*);
+
+        auto run_scalar(const double* chunk_lst, const double* terms, std::size_t num_terms,
+                        double* out, std::size_t n) -> void {
+            for (std::size_t i = 0; i < n; ++i) {
+                auto value = chunk_lst[i];
+                for (std::size_t t = 0; t < num_terms; ++t) {
+                    value += terms[t];
+                }
+                out[i] = value;
+            }
+        }
+
+        auto ramp_scalar(double weight, unsigned long first, const double* terms,
+                         std::size_t num_terms, double* out, std::size_t n) -> void {
+            for (std::size_t i = 0; i < n; ++i) {
+                auto value = weight * double(first + i);
+                for (std::size_t t = 0; t < num_terms; ++t) {
+                    value += terms[t];
+                }
+                out[i] = value;
+            }
+        }
+
+        // The point kernels compute lanes [lane0, lane0 + HALTON_LANES) into out.
+        // Step 0 takes the lowest chunk of a lane, the later steps one digit each.
+
+        auto point_scalar(const HaltonLanes& lanes, std::size_t lane0, unsigned long count,
+                          double* out) -> void {
+            const auto num_lanes = lanes.radix.size();
+            const auto table = [&](std::int32_t offset) {
+                return offset < 0 ? nullptr : lanes.tables.data() + offset;
+            };
+            for (auto lane = lane0; lane < lane0 + HALTON_LANES; ++lane) {
+                auto radix = static_cast<unsigned long>(lanes.radix[lane]);
+                const auto* chunk_lst = table(lanes.offset[lane]);
+                double res = 0.0;
+                auto rest = count;
+                for (std::size_t i = 0; rest != 0; ++i) {
+                    const auto digit = rest % radix;
+                    rest /= radix;
+                    const auto value = chunk_lst != nullptr ? chunk_lst[digit] : double(digit);
+                    res += lanes.weights[i * num_lanes + lane] * value;
+                    radix = static_cast<unsigned long>(lanes.high_radix[lane]);
+                    chunk_lst = table(lanes.high_offset[lane]);
+                }
+                out[lane - lane0] = res;
+            }
+        }
+
+#ifdef LDSGEN_X86_DISPATCH
+        // Runs of values go 4 vectors at a time, so that the chains of
+        // additions of different vectors overlap.
+        constexpr std::size_t RUN_VECTORS = 4;
+
+        __attribute__((target("avx2"))) auto add_terms_avx2(__m256d (&values)[RUN_VECTORS],
+                                                            const double* terms,
+                                                            std::size_t num_terms) -> void {
+            for (std::size_t t = 0; t < num_terms; ++t) {
+                const auto term = _mm256_set1_pd(terms[t]);
+                for (auto& value : values) {
+                    value = _mm256_add_pd(value, term);
+                }
+            }
+        }
+
+        __attribute__((target("avx2"))) auto run_avx2(const double* chunk_lst,
+                                                      const double* terms,
+                                                      std::size_t num_terms, double* out,
+                                                      std::size_t n) -> void {
+            constexpr std::size_t BLOCK = 4 * RUN_VECTORS;
+            std::size_t i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                __m256d values[RUN_VECTORS];
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    values[v] = _mm256_loadu_pd(chunk_lst + i + 4 * v);
+                }
+                add_terms_avx2(values, terms, num_terms);
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    _mm256_storeu_pd(out + i + 4 * v, values[v]);
+                }
+            }
+            run_scalar(chunk_lst + i, terms, num_terms, out + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) auto ramp_avx2(double weight, unsigned long first,
+                                                       const double* terms,
+                                                       std::size_t num_terms, double* out,
+                                                       std::size_t n) -> void {
+            constexpr std::size_t BLOCK = 4 * RUN_VECTORS;
+            const auto vweight = _mm256_set1_pd(weight);
+            std::size_t i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                __m256d values[RUN_VECTORS];
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    const auto digit = first + i + 4 * v;
+                    values[v] = _mm256_mul_pd(
+                        vweight, _mm256_set_pd(double(digit + 3), double(digit + 2),
+                                               double(digit + 1), double(digit)));
+                }
+                add_terms_avx2(values, terms, num_terms);
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    _mm256_storeu_pd(out + i + 4 * v, values[v]);
+                }
+            }
+            ramp_scalar(weight, first + i, terms, num_terms, out + i, n - i);
+        }
+
+        __attribute__((target("avx512f"))) auto add_terms_avx512(
+            __m512d (&values)[RUN_VECTORS], const double* terms, std::size_t num_terms) -> void {
+            for (std::size_t t = 0; t < num_terms; ++t) {
+                const auto term = _mm512_set1_pd(terms[t]);
+                for (auto& value : values) {
+                    value = _mm512_add_pd(value, term);
+                }
+            }
+        }
+
+        __attribute__((target("avx512f"))) auto run_avx512(const double* chunk_lst,
+                                                           const double* terms,
+                                                           std::size_t num_terms, double* out,
+                                                           std::size_t n) -> void {
+            constexpr std::size_t BLOCK = 8 * RUN_VECTORS;
+            std::size_t i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                __m512d values[RUN_VECTORS];
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    values[v] = _mm512_loadu_pd(chunk_lst + i + 8 * v);
+                }
+                add_terms_avx512(values, terms, num_terms);
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    _mm512_storeu_pd(out + i + 8 * v, values[v]);
+                }
+            }
+            run_avx2(chunk_lst + i, terms, num_terms, out + i, n - i);
+        }
+
+        __attribute__((target("avx512f"))) auto ramp_avx512(double weight, unsigned long first,
+                                                            const double* terms,
+                                                            std::size_t num_terms, double* out,
+                                                            std::size_t n) -> void {
+            constexpr std::size_t BLOCK = 8 * RUN_VECTORS;
+            const auto vweight = _mm512_set1_pd(weight);
+            std::size_t i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                __m512d values[RUN_VECTORS];
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    const auto digit = first + i + 8 * v;
+                    values[v] = _mm512_mul_pd(
+                        vweight,
+                        _mm512_set_pd(double(digit + 7), double(digit + 6), double(digit + 5),
+                                      double(digit + 4), double(digit + 3), double(digit + 2),
+                                      double(digit + 1), double(digit)));
+                }
+                add_terms_avx512(values, terms, num_terms);
+                for (std::size_t v = 0; v < RUN_VECTORS; ++v) {
+                    _mm512_storeu_pd(out + i + 8 * v, values[v]);
+                }
+            }
+            ramp_avx2(weight, first + i, terms, num_terms, out + i, n - i);
+        }
+
+        // Lanes that run out of digits early keep dividing zero: their extra
+        // digits are 0 and add +0.0 (a table maps 0 to 0), which leaves the
+        // sum unchanged.
+
+        __attribute__((target("avx2"))) auto point_avx2(const HaltonLanes& lanes,
+                                                        std::size_t lane0, unsigned long count,
+                                                        double* out) -> void {
+            const auto num_lanes = lanes.radix.size();
+            const auto zero = _mm256_setzero_pd();
+            const auto one = _mm256_set1_pd(1.0);
+            for (auto half = lane0; half < lane0 + HALTON_LANES; half += 4) {
+                auto radix = _mm256_loadu_pd(lanes.radix.data() + half);
+                auto inv_radix = _mm256_loadu_pd(lanes.inv_radix.data() + half);
+                auto offset
+                    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.offset.data() + half));
+                auto has_table = _mm256_castsi256_pd(
+                    _mm256_cvtepi32_epi64(_mm_cmpgt_epi32(offset, _mm_set1_epi32(-1))));
+                const auto high_radix = _mm256_loadu_pd(lanes.high_radix.data() + half);
+                const auto inv_high_radix = _mm256_loadu_pd(lanes.inv_high_radix.data() + half);
+                const auto high_offset = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(lanes.high_offset.data() + half));
+                const auto high_has_table = _mm256_castsi256_pd(
+                    _mm256_cvtepi32_epi64(_mm_cmpgt_epi32(high_offset, _mm_set1_epi32(-1))));
+                auto res = zero;
+                auto rest = _mm256_set1_pd(double(count));
+                for (std::size_t i = 0;
+                     _mm256_movemask_pd(_mm256_cmp_pd(rest, zero, _CMP_NEQ_OQ)) != 0; ++i) {
+                    auto quot = _mm256_floor_pd(_mm256_mul_pd(rest, inv_radix));
+                    auto digit = _mm256_sub_pd(rest, _mm256_mul_pd(quot, radix));
+                    const auto low = _mm256_cmp_pd(digit, zero, _CMP_LT_OQ);
+                    quot = _mm256_sub_pd(quot, _mm256_and_pd(low, one));
+                    digit = _mm256_add_pd(digit, _mm256_and_pd(low, radix));
+                    const auto high = _mm256_cmp_pd(digit, radix, _CMP_GE_OQ);
+                    quot = _mm256_add_pd(quot, _mm256_and_pd(high, one));
+                    digit = _mm256_sub_pd(digit, _mm256_and_pd(high, radix));
+                    const auto index = _mm_add_epi32(offset, _mm256_cvttpd_epi32(digit));
+                    const auto value
+                        = _mm256_mask_i32gather_pd(digit, lanes.tables.data(), index, has_table, 8);
+                    const auto weight
+                        = _mm256_loadu_pd(lanes.weights.data() + i * num_lanes + half);
+                    res = _mm256_add_pd(res, _mm256_mul_pd(weight, value));
+                    rest = quot;
+                    radix = high_radix;
+                    inv_radix = inv_high_radix;
+                    offset = high_offset;
+                    has_table = high_has_table;
+                }
+                _mm256_storeu_pd(out + (half - lane0), res);
+            }
+        }
+
+        __attribute__((target("avx512f"))) auto point_avx512(const HaltonLanes& lanes,
+                                                             std::size_t lane0,
+                                                             unsigned long count, double* out)
+            -> void {
+            // the masked forms of the conversions avoid GCC's -Wuninitialized false positives
+            constexpr __mmask8 ALL = 0xFF;
+            const auto num_lanes = lanes.radix.size();
+            const auto zero = _mm512_setzero_pd();
+            const auto one = _mm512_set1_pd(1.0);
+            auto radix = _mm512_loadu_pd(lanes.radix.data() + lane0);
+            auto inv_radix = _mm512_loadu_pd(lanes.inv_radix.data() + lane0);
+            auto offset
+                = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.offset.data() + lane0));
+            auto has_table = _mm512_cmpge_epi64_mask(_mm512_maskz_cvtepi32_epi64(ALL, offset),
+                                                     _mm512_setzero_si512());
+            const auto high_radix = _mm512_loadu_pd(lanes.high_radix.data() + lane0);
+            const auto inv_high_radix = _mm512_loadu_pd(lanes.inv_high_radix.data() + lane0);
+            const auto high_offset = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(lanes.high_offset.data() + lane0));
+            const auto high_has_table = _mm512_cmpge_epi64_mask(
+                _mm512_maskz_cvtepi32_epi64(ALL, high_offset), _mm512_setzero_si512());
+            auto res = zero;
+            auto rest = _mm512_set1_pd(double(count));
+            for (std::size_t i = 0; _mm512_cmp_pd_mask(rest, zero, _CMP_NEQ_OQ) != 0; ++i) {
+                const auto scaled = _mm512_mul_pd(rest, inv_radix);
+                auto quot = _mm512_mask_roundscale_pd(scaled, ALL, scaled, _MM_FROUND_FLOOR);
+                auto digit = _mm512_sub_pd(rest, _mm512_mul_pd(quot, radix));
+                const auto low = _mm512_cmp_pd_mask(digit, zero, _CMP_LT_OQ);
+                quot = _mm512_mask_sub_pd(quot, low, quot, one);
+                digit = _mm512_mask_add_pd(digit, low, digit, radix);
+                const auto high = _mm512_cmp_pd_mask(digit, radix, _CMP_GE_OQ);
+                quot = _mm512_mask_add_pd(quot, high, quot, one);
+                digit = _mm512_mask_sub_pd(digit, high, digit, radix);
+                const auto index = _mm256_add_epi32(offset, _mm512_maskz_cvttpd_epi32(ALL, digit));
+                const auto value
+                    = _mm512_mask_i32gather_pd(digit, has_table, index, lanes.tables.data(), 8);
+                const auto weight = _mm512_loadu_pd(lanes.weights.data() + i * num_lanes + lane0);
+                res = _mm512_add_pd(res, _mm512_mul_pd(weight, value));
+                rest = quot;
+                radix = high_radix;
+                inv_radix = inv_high_radix;
+                offset = high_offset;
+                has_table = high_has_table;
+            }
+            _mm512_storeu_pd(out, res);
+        }
+#endif
+
+        struct Kernels {
+            RunKernel run;
+            RampKernel ramp;
+            PointKernel point;
+            const char* name;
+        };
+
+        auto select_kernels() -> Kernels {
+#ifdef LDSGEN_X86_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return {run_avx512, ramp_avx512, point_avx512, "avx512f"};
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return {run_avx2, ramp_avx2, point_avx2, "avx2"};
+            }
+#endif
+            return {run_scalar, ramp_scalar, point_scalar, "scalar"};
+        }
+
+        auto kernels() -> const Kernels& {
+            static const Kernels selected = select_kernels();
+            return selected;
+        }
+
+    }  // namespace
+
+    auto vdc_digits(unsigned long count, const FastDivider& base,
+                    const std::array<double, MAX_REVERSE_BITS>& rev_lst, unsigned int position,
+                    double res) -> double {
+        return vdc_table(count, base, rev_lst, position, res);
+    }
+
+    VdcOdometer::VdcOdometer(const unsigned long base,
+                             const std::array<double, MAX_REVERSE_BITS>& rev_lst,
+                             unsigned long index, std::span<const double> chunk_lst)
+        : base{base},
+          rev_lst{&rev_lst},
+          chunk_lst{chunk_lst},
+          radix{chunk_lst.empty() ? base : static_cast<unsigned long>(chunk_lst.size())},
+          low_digits{chunk_lst.empty() ? 1 : chunk_digits(base)},
+          count{index} {
+        if (base == 2) {
+            return;
+        }
+        this->low = index % this->radix;
+        for (index /= this->radix; index != 0; index /= base) {
+            this->set_digit(this->num_digits++, index % base);
+        }
+    }
+
+    auto VdcOdometer::pop() -> double {
+        if (this->base == 2) {
+            return vdc_base2(++this->count);
+        }
+        if (++this->low == this->radix) {
+            this->low = 0;
+            this->carry();
+        }
+        auto res = this->chunk_lst.empty() ? (*this->rev_lst)[0] * double(this->low)
+                                           : this->chunk_lst[this->low];
+        for (unsigned int i = 0; i < this->num_digits; ++i) {
+            res += this->terms[i];
+        }
+        return res;
+    }
+
+    auto VdcOdometer::fill(std::span<double> out) -> void {
+        if (this->base == 2) {
+            constexpr auto RADIX = chunk_radix(2);
+            while (!out.empty()) {
+                const auto next = this->count + 1;
+                const auto low_bits = next % RADIX;
+                const auto run = std::min<std::size_t>(out.size(), RADIX - low_bits);
+                const auto high = vdc_base2(next - low_bits);
+                vdc_run(CHUNK_TABLE<2>.data() + low_bits, std::span(&high, 1), out.first(run));
+                this->count += run;
+                out = out.subspan(run);
+            }
+            return;
+        }
+        while (!out.empty()) {
+            const auto first = this->low + 1;
+            if (first == this->radix) {
+                out.front() = this->pop();
+                out = out.subspan(1);
+                continue;
+            }
+            const auto run = std::min<std::size_t>(out.size(), this->radix - first);
+            const auto terms = std::span<const double>(this->terms).first(this->num_digits);
+            if (!this->chunk_lst.empty()) {
+                vdc_run(this->chunk_lst.data() + first, terms, out.first(run));
+            } else {
+                vdc_ramp((*this->rev_lst)[0], first, terms, out.first(run));
+            }
+            this->low += run;
+            out = out.subspan(run);
+        }
+    }
+
+    auto VdcOdometer::set_digit(unsigned int i, unsigned long digit) -> void {
+        this->digits[i] = digit;
+        this->terms[i] = (*this->rev_lst)[this->low_digits + i] * double(digit);
+    }
+
+    // Add one to the digits above the lowest chunk.
+    auto VdcOdometer::carry() -> void {
+        unsigned int idx = 0;
+        while (idx < this->num_digits && this->digits[idx] == this->base - 1) {
+            this->set_digit(idx++, 0);
+        }
+        if (idx == this->num_digits) {
+            ++this->num_digits;
+        }
+        this->set_digit(idx, this->digits[idx] + 1);
+    }
+
+    auto vdc_run(const double* chunk_lst, std::span<const double> terms, std::span<double> out)
+        -> void {
+        kernels().run(chunk_lst, terms.data(), terms.size(), out.data(), out.size());
+    }
+
+    auto vdc_ramp(double weight, unsigned long first, std::span<const double> terms,
+                  std::span<double> out) -> void {
+        kernels().ramp(weight, first, terms.data(), terms.size(), out.data(), out.size());
+    }
+
+    auto vdc_kernel_name() -> const char* { return kernels().name; }
+
+    auto halton_point(const HaltonLanes& lanes, unsigned long count, std::span<double> out)
+        -> void {
+        const auto point = kernels().point;
+        std::array<double, HALTON_LANES> group;
+        for (std::size_t lane0 = 0; lane0 < lanes.dim; lane0 += HALTON_LANES) {
+            if (lanes.dim - lane0 >= HALTON_LANES) {
+                point(lanes, lane0, count, out.data() + lane0);
+            } else {
+                point(lanes, lane0, count, group.data());
+                std::copy_n(group.begin(), lanes.dim - lane0, out.begin() + std::ptrdiff_t(lane0));
+            }
+        }
+    }
+
+}  // namespace ldsgen
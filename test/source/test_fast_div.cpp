@@ -0,0 +1,69 @@
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase, CHECK_EQ
+
+#include <array>                // for array
+#include <cstdint>              // for uint64_t
+#include <ldsgen/fast_div.hpp>  // for FastDivider
+#include <ldsgen/ilds.hpp>      // for VdCorput
+#include <ldsgen/lds.hpp>       // for PRIME_TABLE, VdCorput, vdc
+#include <limits>               // for numeric_limits
+
+TEST_CASE("FastDivider matches hardware division for all table primes") {
+    constexpr auto MAX = std::numeric_limits<std::uint64_t>::max();
+    for (const auto prime : ldsgen::PRIME_TABLE) {
+        const auto divisor = ldsgen::FastDivider(prime);
+        const std::uint64_t dividend = prime;
+        const std::array<std::uint64_t, 12> numers{0,
+                                                   1,
+                                                   dividend - 1,
+                                                   dividend,
+                                                   dividend + 1,
+                                                   dividend * dividend - 1,
+                                                   dividend * dividend,
+                                                   0x123456789ABCDEFULL,
+                                                   (MAX / dividend) * dividend,
+                                                   (MAX / dividend) * dividend - 1,
+                                                   MAX - 1,
+                                                   MAX};
+        for (const auto numer : numers) {
+            REQUIRE_EQ(numer / divisor, numer / dividend);
+            REQUIRE_EQ(numer % divisor, numer % dividend);
+        }
+        for (std::uint64_t numer = 0; numer < 4 * dividend; ++numer) {
+            REQUIRE_EQ(numer / divisor, numer / dividend);
+        }
+    }
+}
+
+TEST_CASE("FastDivider powers of two and other divisors") {
+    constexpr auto MAX = std::numeric_limits<std::uint64_t>::max();
+    for (unsigned int k = 1; k < 64; ++k) {
+        const std::uint64_t dividend = std::uint64_t{1} << k;
+        const auto divisor = ldsgen::FastDivider(dividend);
+        CHECK_EQ(MAX / divisor, MAX >> k);
+        CHECK_EQ((dividend + 3) / divisor, (dividend + 3) / dividend);
+    }
+    const auto divisor = ldsgen::FastDivider(MAX);
+    CHECK_EQ(MAX / divisor, 1);
+    CHECK_EQ((MAX - 1) / divisor, 0);
+    static_assert(100 / ldsgen::FastDivider(7) == 14);
+    static_assert(100 % ldsgen::FastDivider(7) == 2);
+}
+
+TEST_CASE("VdCorput with FastDivider matches vdc for all table primes") {
+    for (const auto prime : ldsgen::PRIME_TABLE) {
+        auto vgen = ldsgen::VdCorput(prime);
+        for (const unsigned long index : {0UL, 1UL, prime - 1, prime, 123456789UL, 1UL << 40U}) {
+            REQUIRE_EQ(vgen.at(index), doctest::Approx(ldsgen::vdc(index + 1, prime)));
+        }
+    }
+}
+
+TEST_CASE("VdCorput_i with FastDivider for all table primes") {
+    for (const auto prime : ldsgen::PRIME_TABLE) {
+        auto vgen = ildsgen::VdCorput(prime, 3);
+        vgen.reseed(prime * prime);  // count = p^2 + 1, digits (1, 0, 1) reverse to themselves
+        CHECK_EQ(vgen.pop(), prime * prime + 1);
+        vgen.reseed(prime);  // count = p + 1, digits (1, 1, 0) reverse to (0, 1, 1)
+        CHECK_EQ(vgen.pop(), prime * prime + prime);
+    }
+}
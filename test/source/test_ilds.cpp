@@ -58,3 +58,17 @@ TEST_CASE("Halton_i different bases and scales") {
     CHECK_EQ(res[0], 243);  // 3^5 = 243
     CHECK_EQ(res[1], 125);  // 5^3 = 125
 }
+
+TEST_CASE("VdCorput_i and Halton_i fork") {
+    auto vgen = ildsgen::VdCorput(2, 10);
+    auto fork = vgen.fork(2);  // the count is incremented before each value
+    CHECK_EQ(fork.pop(), 768);
+    auto copy = fork;
+    CHECK_EQ(copy.pop(), fork.pop());
+    CHECK_EQ(vgen.pop(), 512);
+
+    auto hgen = ildsgen::Halton({2, 3}, {11, 7});
+    auto href = ildsgen::Halton({2, 3}, {11, 7});
+    href.reseed(5);
+    CHECK_EQ(hgen.fork(5).pop(), href.pop());
+}
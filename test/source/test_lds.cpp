@@ -1,8 +1,17 @@
 #include <doctest/doctest.h>  // for Approx, ResultBuilder, TestCase, CHECK
 
 #include <algorithm>       // for std::sort
+#include <array>           // for std::array
+#include <cmath>           // for std::fabs
 #include <cstddef>         // for std::size_t
+#include <iterator>        // for std::random_access_iterator
 #include <ldsgen/lds.hpp>  // for Circle, Halton, Sphere, Sphere3Hopf
+#include <ranges>          // for std::ranges::transform
+#include <span>            // for std::span
+#include <string>          // for std::string
+#include <type_traits>     // for std::is_copy_constructible_v
+#include <utility>         // for std::declval
+#include <vector>          // for std::vector
 
 TEST_CASE("vdc") { CHECK_EQ(ldsgen::vdc(11, 2), doctest::Approx(0.8125)); }
 
@@ -652,3 +661,566 @@ TEST_CASE("get_index") {
     vgen.reseed(5);
     CHECK_EQ(vgen.get_index(), 5);
 }
+
+TEST_CASE("VdCorput::fill") {
+    auto vgen = ldsgen::VdCorput(3);
+    auto vref = ldsgen::VdCorput(3);
+    std::vector<double> values(100);
+    vgen.fill(values);
+    for (const auto& value : values) {
+        CHECK_EQ(value, vref.pop());
+    }
+    CHECK_EQ(vgen.get_index(), 100);
+    CHECK_EQ(vgen.pop(), vref.pop());
+}
+
+TEST_CASE("VdCorput::fill from start index") {
+    const auto vgen = ldsgen::VdCorput(2);
+    std::vector<double> values(4);
+    vgen.fill(4, values);
+    CHECK_EQ(values[0], doctest::Approx(0.625));
+    CHECK_EQ(values[1], doctest::Approx(0.375));
+    CHECK_EQ(values[2], doctest::Approx(0.875));
+    CHECK_EQ(values[3], doctest::Approx(0.0625));
+    CHECK_EQ(vgen.get_index(), 0);
+    CHECK_EQ(vgen.at(4), values[0]);
+}
+
+TEST_CASE("Halton::fill") {
+    auto hgen = ldsgen::Halton(2, 3);
+    auto href = ldsgen::Halton(2, 3);
+    std::vector<std::array<double, 2>> points(50);
+    hgen.fill(points);
+    for (const auto& point : points) {
+        CHECK_EQ(point, href.pop());
+    }
+    CHECK_EQ(hgen.pop(), href.pop());
+}
+
+TEST_CASE("Circle/Disk/Sphere/Sphere3Hopf::fill") {
+    auto cgen = ldsgen::Circle(2);
+    auto dgen = ldsgen::Disk(2, 3);
+    auto sgen = ldsgen::Sphere(2, 3);
+    auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    std::vector<std::array<double, 2>> circle(20);
+    std::vector<std::array<double, 2>> disk(20);
+    std::vector<std::array<double, 3>> sphere(20);
+    std::vector<std::array<double, 4>> sphere3(20);
+    cgen.skip(5);
+    cgen.fill(circle);
+    dgen.fill(3, disk);
+    sgen.fill(sphere);
+    shfgen.fill(sphere3);
+    cgen.reseed(5);
+    dgen.reseed(3);
+    sgen.reseed(0);
+    shfgen.reseed(0);
+    for (std::size_t i = 0; i < 20; ++i) {
+        CHECK_EQ(circle[i], cgen.pop());
+        CHECK_EQ(disk[i], dgen.pop());
+        CHECK_EQ(sphere[i], sgen.pop());
+        CHECK_EQ(sphere3[i], shfgen.pop());
+    }
+}
+
+TEST_CASE("Circle/Disk/Sphere/Sphere3Hopf::fill_soa") {
+    constexpr std::size_t NUM = 600;  // more than one FILL_BLOCK
+    auto cgen = ldsgen::Circle(3);
+    const auto dgen = ldsgen::Disk(2, 3);
+    const auto sgen = ldsgen::Sphere(2, 3);
+    const auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    std::vector<std::vector<double>> coords(4, std::vector<double>(NUM));
+    cgen.skip(7);
+    cgen.fill_soa({coords[0], coords[1]});
+    CHECK_EQ(cgen.get_index(), 7 + NUM);
+    for (std::size_t i = 0; i < NUM; ++i) {
+        const auto point = std::array{coords[0][i], coords[1][i]};
+        CHECK_EQ(point, cgen.at(7 + i));
+    }
+    dgen.fill_soa(3, {coords[0], coords[1]});
+    for (std::size_t i = 0; i < NUM; ++i) {
+        const auto point = std::array{coords[0][i], coords[1][i]};
+        CHECK_EQ(point, dgen.at(3 + i));
+    }
+    sgen.fill_soa(0, {coords[0], coords[1], coords[2]});
+    for (std::size_t i = 0; i < NUM; ++i) {
+        const auto point = std::array{coords[0][i], coords[1][i], coords[2][i]};
+        CHECK_EQ(point, sgen.at(i));
+    }
+    shfgen.fill_soa(1, {coords[0], coords[1], coords[2], coords[3]});
+    for (std::size_t i = 0; i < NUM; ++i) {
+        const auto point = std::array{coords[0][i], coords[1][i], coords[2][i], coords[3][i]};
+        CHECK_EQ(point, shfgen.at(1 + i));
+    }
+}
+
+TEST_CASE("VdcOdometer is bit-identical to VdCorput::at") {
+    for (const unsigned long base : {2UL, 3UL, 5UL, 7UL, 11UL, 1009UL}) {
+        const auto vgen = ldsgen::VdCorput(base);
+        for (const unsigned long start : {0UL, 1UL, base - 1, base * base - 2, 123456789UL}) {
+            auto odo = vgen.odometer(start);
+            for (unsigned long i = 0; i < 3000; ++i) {
+                REQUIRE_EQ(odo.pop(), vgen.at(start + i));
+            }
+        }
+    }
+}
+
+// The digit loop of the original VdCorput::pop(), least significant digit first. The
+// volatile keeps each product rounded on its own when this file is built with FMA.
+auto original_pop(unsigned long count, unsigned long base) -> double {
+    auto rev_lst = std::array<double, 64>{};
+    double reverse = 1.0;
+    for (auto& rev : rev_lst) {
+        reverse /= double(base);
+        rev = reverse;
+    }
+    unsigned long idx = 0;
+    double res = 0.0;
+    while (count != 0) {
+        const auto remainder = count % base;
+        count /= base;
+        const volatile double term = rev_lst[idx] * double(remainder);
+        res += term;
+        ++idx;
+    }
+    return res;
+}
+
+TEST_CASE("VdCorput is bit-identical to the original digit loop") {
+    std::vector<double> values(20000);
+    for (const unsigned long base : {2UL, 3UL, 5UL, 7UL, 11UL, 13UL, 32UL, 37UL, 101UL, 1009UL}) {
+        const auto vgen = ldsgen::VdCorput(base);
+        for (const unsigned long start : {0UL, 2000000UL, (1UL << 40U) - 7}) {
+            vgen.fill(start, values);
+            for (unsigned long i = 0; i < values.size(); ++i) {
+                REQUIRE_EQ(vgen.at(start + i), original_pop(start + i + 1, base));
+                REQUIRE_EQ(values[i], original_pop(start + i + 1, base));
+            }
+        }
+    }
+    const auto vtgen = ldsgen::VdCorputT<5>();
+    for (unsigned long index = 0; index < 100000; ++index) {
+        REQUIRE_EQ(vtgen.at(index), original_pop(index + 1, 5));
+    }
+}
+
+TEST_CASE("reverse_bits") {
+    CHECK_EQ(ldsgen::reverse_bits(0), 0);
+    CHECK_EQ(ldsgen::reverse_bits(1), 0x8000000000000000ULL);
+    CHECK_EQ(ldsgen::reverse_bits(0x00000000000000F1ULL), 0x8F00000000000000ULL);
+    CHECK_EQ(ldsgen::reverse_bits(ldsgen::reverse_bits(0x0123456789ABCDEFULL)),
+             0x0123456789ABCDEFULL);
+}
+
+TEST_CASE("vdc_base2 matches the generic digit loop") {
+    static_assert(ldsgen::vdc_base2(11) == 0.8125);
+    const auto vgen = ldsgen::VdCorput(2);
+    for (const unsigned long start : {0UL, 1000UL, (1UL << 40U) - 7, (1UL << 53U) - 1000}) {
+        for (unsigned long k = start; k < start + 1000; ++k) {
+            REQUIRE_EQ(ldsgen::vdc_base2(k), ldsgen::vdc(k, 2));
+            REQUIRE_EQ(vgen.at(k - 1), ldsgen::vdc(k, 2));
+        }
+    }
+}
+
+TEST_CASE("VdCorputT matches VdCorput") {
+    auto vgen = ldsgen::VdCorput(3);
+    auto vtgen = ldsgen::VdCorputT<3>();
+    static_assert(ldsgen::RadicalInverseT<3>().at(0) == 1.0 / 3.0);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(vtgen.pop(), vgen.pop());
+    }
+    std::vector<double> values(100);
+    std::vector<double> expected(100);
+    vtgen.fill(values);
+    vgen.fill(expected);
+    CHECK_EQ(values, expected);
+    vtgen.reseed(5);
+    CHECK_EQ(vtgen.pop(), doctest::Approx(2.0 / 9.0));
+}
+
+TEST_CASE("HaltonT/CircleT/DiskT/SphereT/Sphere3HopfT match the runtime classes") {
+    auto hgen = ldsgen::Halton(2, 3);
+    auto cgen = ldsgen::Circle(5);
+    auto dgen = ldsgen::Disk(2, 3);
+    auto sgen = ldsgen::Sphere(2, 3);
+    auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    auto htgen = ldsgen::HaltonT<2, 3>();
+    auto ctgen = ldsgen::CircleT<5>();
+    auto dtgen = ldsgen::DiskT<2, 3>();
+    auto stgen = ldsgen::SphereT<2, 3>();
+    auto shftgen = ldsgen::Sphere3HopfT<2, 3, 5>();
+    for (int i = 0; i < 100; ++i) {
+        CHECK_EQ(htgen.pop(), hgen.pop());
+        CHECK_EQ(ctgen.pop(), cgen.pop());
+        CHECK_EQ(dtgen.pop(), dgen.pop());
+        CHECK_EQ(stgen.pop(), sgen.pop());
+        CHECK_EQ(shftgen.pop(), shfgen.pop());
+    }
+    std::vector<std::array<double, 3>> points(10);
+    stgen.fill(0, points);
+    CHECK_EQ(points[1], sgen.at(1));
+}
+
+TEST_CASE("Digit-chunk tables") {
+    static_assert(ldsgen::chunk_digits(3) == 6 && ldsgen::chunk_radix(3) == 729);
+    static_assert(ldsgen::chunk_radix(5) == 625 && ldsgen::chunk_radix(7) == 343);
+    static_assert(ldsgen::chunk_radix(32) == 1024 && ldsgen::chunk_digits(1009) == 1);
+    static_assert(ldsgen::has_chunk_table(3) && ldsgen::has_chunk_table(32));
+    static_assert(!ldsgen::has_chunk_table(2) && !ldsgen::has_chunk_table(33));
+    static_assert(ldsgen::RadicalInverseT<7>().at(8) == 2 * (1.0 / 7) + 1.0 / 7 / 7);  // 12 base 7
+    CHECK_EQ(ldsgen::chunk_table(2), nullptr);
+    CHECK_EQ(ldsgen::chunk_table(33), nullptr);
+    CHECK_EQ(ldsgen::chunk_table(7), ldsgen::CHUNK_TABLE<7>.data());
+    CHECK_EQ(ldsgen::CHUNK_TABLE<3>[1], 1.0 / 3.0);
+    CHECK_EQ(ldsgen::CHUNK_TABLE<3>[4], original_pop(4, 3));
+    for (unsigned long base = 3; base <= 40; ++base) {
+        const auto vgen = ldsgen::VdCorput(base);
+        for (const unsigned long start : {0UL, 1000UL, (1UL << 40U) - 7}) {
+            for (unsigned long index = start; index < start + 1100; ++index) {
+                REQUIRE_EQ(vgen.at(index), doctest::Approx(ldsgen::vdc(index + 1, base)));
+            }
+        }
+        auto odo = vgen.odometer(1020);
+        for (unsigned long index = 1020; index < 3100; ++index) {
+            REQUIRE_EQ(odo.pop(), vgen.at(index));
+        }
+    }
+}
+
+TEST_CASE("VdcOdometer::fill matches VdCorput::at") {
+    const std::string name = ldsgen::vdc_kernel_name();
+    CHECK((name == "avx512f" || name == "avx2" || name == "scalar"));
+    std::vector<double> values(5000);
+    for (const unsigned long base : {2UL, 3UL, 7UL, 32UL, 37UL, 1009UL}) {
+        const auto vgen = ldsgen::VdCorput(base);
+        for (const unsigned long start : {0UL, 1UL, base - 2, 123456789UL, (1UL << 53U) - 77}) {
+            auto odo = vgen.odometer(start);
+            // uneven pieces, so that runs get cut at every possible offset
+            std::size_t offset = 0;
+            for (std::size_t size = 1; offset + size <= values.size(); size += 13) {
+                odo.fill(std::span(values).subspan(offset, size));
+                offset += size;
+            }
+            for (std::size_t i = 0; i < offset; ++i) {
+                REQUIRE_EQ(values[i], vgen.at(start + i));
+            }
+            CHECK_EQ(odo.pop(), vgen.at(start + offset));
+        }
+    }
+}
+
+TEST_CASE("sincos_run and sqrt_run match the scalar functions") {
+    const std::string name = ldsgen::sincos_kernel_name();
+    CHECK((name == "avx512f" || name == "avx2" || name == "scalar"));
+    const auto quarter = ldsgen::sincos_turns(0.25);
+    const auto half = ldsgen::sincos_turns(0.5);
+    CHECK_EQ(quarter[0], 0.0);
+    CHECK_EQ(quarter[1], 1.0);
+    CHECK_EQ(half[0], -1.0);
+    CHECK_EQ(half[1], 0.0);
+    std::vector<double> turns(1001);  // not a multiple of the vector width
+    for (std::size_t i = 0; i < turns.size(); ++i) {
+        turns[i] = ldsgen::vdc(i + 1, 3) + ldsgen::vdc(i + 1, 2);  // phi + psi of Sphere3Hopf
+    }
+    std::vector<std::array<double, 2>> units(turns.size());
+    ldsgen::sincos_run(turns, units);
+    std::vector<double> roots(turns.size());
+    ldsgen::sqrt_run(turns, roots);
+    for (std::size_t i = 0; i < turns.size(); ++i) {
+        REQUIRE_EQ(units[i], ldsgen::sincos_turns(turns[i]));
+        REQUIRE_EQ(units[i][0], doctest::Approx(std::cos(turns[i] * ldsgen::TWO_PI)).epsilon(1e-14));
+        REQUIRE_EQ(units[i][1], doctest::Approx(std::sin(turns[i] * ldsgen::TWO_PI)).epsilon(1e-14));
+        REQUIRE_EQ(roots[i], std::sqrt(turns[i]));
+    }
+}
+
+// The double generators map through sincos_turns(), not std::cos/std::sin of
+// vdc * TWO_PI as before. The points moved by at most 1e-15 (Sphere3Hopf:
+// 4e-15, as its libm reference also rounds phi + psi in radians).
+TEST_CASE("double generators stay close to the libm mapping") {
+    const auto circle = ldsgen::Circle(3);
+    const auto disk = ldsgen::Disk(2, 3);
+    const auto sphere = ldsgen::Sphere(2, 3);
+    const auto sphere3 = ldsgen::Sphere3Hopf(2, 3, 5);
+    const auto max_diff = [](const auto& lhs, const auto& rhs) {
+        auto diff = 0.0;
+        for (std::size_t k = 0; k < lhs.size(); ++k) {
+            diff = std::max(diff, std::fabs(lhs[k] - rhs[k]));
+        }
+        return diff;
+    };
+    const auto vgen2 = ldsgen::VdCorput(2);
+    const auto vgen3 = ldsgen::VdCorput(3);
+    const auto vgen5 = ldsgen::VdCorput(5);
+    for (const unsigned long start : {0UL, 1UL << 40U}) {
+        for (auto index = start; index < start + 10000; ++index) {
+            const auto vdc2 = vgen2.at(index);
+            const auto vdc3 = vgen3.at(index);
+            const auto vdc5 = vgen5.at(index);
+            const auto theta = vdc3 * ldsgen::TWO_PI;
+            REQUIRE_LE(max_diff(circle.at(index), std::array{std::cos(theta), std::sin(theta)}),
+                       1e-15);
+            const auto radius = std::sqrt(vdc3);
+            const auto phi = vdc2 * ldsgen::TWO_PI;
+            REQUIRE_LE(max_diff(disk.at(index),
+                                std::array{radius * std::cos(phi), radius * std::sin(phi)}),
+                       1e-15);
+            const auto cosphi = 2.0 * vdc2 - 1.0;
+            const auto sinphi = std::sqrt(1.0 - cosphi * cosphi);
+            REQUIRE_LE(max_diff(sphere.at(index), std::array{sinphi * std::cos(theta),
+                                                             sinphi * std::sin(theta), cosphi}),
+                       1e-15);
+            const auto cos_eta = std::sqrt(vdc5);
+            const auto sin_eta = std::sqrt(1.0 - vdc5);
+            const auto psy = vdc3 * ldsgen::TWO_PI;
+            REQUIRE_LE(max_diff(sphere3.at(index),
+                                std::array{cos_eta * std::cos(psy), cos_eta * std::sin(psy),
+                                           sin_eta * std::cos(phi + psy),
+                                           sin_eta * std::sin(phi + psy)}),
+                       4e-15);
+        }
+    }
+}
+
+TEST_CASE("Local generators match the thread-safe ones") {
+    auto vgen = ldsgen::VdCorput(3);
+    auto lvgen = ldsgen::LocalVdCorput(3);
+    auto lvtgen = ldsgen::LocalVdCorputT<3>();
+    auto hgen = ldsgen::Halton(2, 3);
+    auto lhgen = ldsgen::LocalHalton(2, 3);
+    auto sgen = ldsgen::Sphere(2, 3);
+    auto lsgen = ldsgen::LocalSphere(2, 3);
+    auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    auto lshfgen = ldsgen::LocalSphere3Hopf(2, 3, 5);
+    auto dgen = ldsgen::Disk(2, 3);
+    auto ldgen = ldsgen::LocalDisk(2, 3);
+    auto cgen = ldsgen::Circle(2);
+    auto lcgen = ldsgen::LocalCircle(2);
+    for (int i = 0; i < 100; ++i) {
+        const auto value = vgen.pop();
+        CHECK_EQ(lvgen.pop(), value);
+        CHECK_EQ(lvtgen.pop(), value);
+        CHECK_EQ(lhgen.pop(), hgen.pop());
+        CHECK_EQ(lsgen.pop(), sgen.pop());
+        CHECK_EQ(lshfgen.pop(), shfgen.pop());
+        CHECK_EQ(ldgen.pop(), dgen.pop());
+        CHECK_EQ(lcgen.pop(), cgen.pop());
+    }
+    lvgen.reseed(5);
+    lvgen.skip(2);
+    CHECK_EQ(lvgen.get_index(), 7);
+    CHECK_EQ(lvgen.peek(), vgen.at(7));
+    CHECK_EQ(lvgen.claim(10), 7);
+    CHECK_EQ(lvgen.get_index(), 17);
+}
+
+TEST_CASE("Float generators are within 1e-6 of the double ones") {
+    constexpr std::size_t NUM = 5000;
+    const auto near = [](const auto& lhs, const auto& rhs) {
+        for (std::size_t k = 0; k < lhs.size(); ++k) {
+            if (std::fabs(double(lhs[k]) - rhs[k]) > 1e-6) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const auto vgen = ldsgen::VdCorput(3);
+    auto vfgen = ldsgen::VdCorputF(3);
+    auto values = std::vector<float>(NUM);
+    vfgen.fill(values);
+    for (std::size_t i = 0; i < NUM; ++i) {
+        CHECK_EQ(values[i], static_cast<float>(vgen.at(i)));
+    }
+    CHECK_EQ(vfgen.pop(), static_cast<float>(vgen.at(NUM)));
+
+    const auto hgen = ldsgen::Halton(2, 3);
+    const auto hfgen = ldsgen::HaltonF(2, 3);
+    const auto cgen = ldsgen::Circle(3);
+    const auto cfgen = ldsgen::CircleF(3);
+    const auto dgen = ldsgen::Disk(2, 3);
+    const auto dfgen = ldsgen::DiskF(2, 3);
+    const auto sgen = ldsgen::Sphere(2, 3);
+    const auto sfgen = ldsgen::SphereF(2, 3);
+    const auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    const auto shffgen = ldsgen::Sphere3HopfF(2, 3, 5);
+    auto halton = std::vector<std::array<float, 2>>(NUM);
+    auto circle = std::vector<std::array<float, 2>>(NUM);
+    auto disk = std::vector<std::array<float, 2>>(NUM);
+    auto sphere = std::vector<std::array<float, 3>>(NUM);
+    auto sphere3 = std::vector<std::array<float, 4>>(NUM);
+    hfgen.fill(0, halton);
+    cfgen.fill(0, circle);
+    dfgen.fill(0, disk);
+    sfgen.fill(0, sphere);
+    shffgen.fill(0, sphere3);
+    for (std::size_t i = 0; i < NUM; ++i) {
+        CHECK(near(halton[i], hgen.at(i)));
+        CHECK(near(circle[i], cgen.at(i)));
+        CHECK(near(disk[i], dgen.at(i)));
+        CHECK(near(sphere[i], sgen.at(i)));
+        CHECK(near(sphere3[i], shfgen.at(i)));
+        CHECK_EQ(sphere[i], sfgen.at(i));
+    }
+
+    auto xs = std::vector<float>(NUM);
+    auto ys = std::vector<float>(NUM);
+    auto zs = std::vector<float>(NUM);
+    sfgen.fill_soa(0, {xs, ys, zs});
+    for (std::size_t i = 0; i < NUM; ++i) {
+        const auto point = std::array{xs[i], ys[i], zs[i]};
+        CHECK_EQ(point, sphere[i]);
+    }
+}
+
+TEST_CASE("Concurrent Halton output is a permutation of the sequence") {
+    const int num_threads = 8;
+    const int values_per_thread = 500;
+    ldsgen::Halton hgen(2, 3);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::array<double, 2>>> results(num_threads);
+
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&hgen, &results, i]() {
+            for (int j = 0; j < values_per_thread; ++j) {
+                results[i].emplace_back(hgen.pop());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // every point pairs both coordinates from one index
+    std::vector<std::array<double, 2>> all_points;
+    for (const auto& thread_results : results) {
+        all_points.insert(all_points.end(), thread_results.begin(), thread_results.end());
+    }
+    std::vector<std::array<double, 2>> expected;
+    for (unsigned long k = 0; k < num_threads * values_per_thread; ++k) {
+        expected.emplace_back(hgen.at(k));
+    }
+    std::ranges::sort(all_points);
+    std::ranges::sort(expected);
+    CHECK_EQ(all_points, expected);
+    CHECK_EQ(hgen.get_index(), num_threads * values_per_thread);
+
+    auto sgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    sgen.skip(3);
+    CHECK_EQ(sgen.claim(4), 3);
+    sgen.reseed(10);
+    CHECK_EQ(sgen.get_index(), 10);
+    CHECK_EQ(sgen.pop(), sgen.at(10));
+}
+
+TEST_CASE("BlockCursor") {
+    const int num_threads = 4;
+    const std::size_t block_size = 64;
+    const std::size_t points_per_thread = 3 * block_size;
+    auto sgen = ldsgen::Sphere(2, 3);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::array<double, 3>>> results(num_threads);
+
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&sgen, &results, i, block_size, points_per_thread]() {
+            auto cursor = ldsgen::BlockCursor(sgen, block_size);
+            for (std::size_t j = 0; j < points_per_thread; ++j) {
+                const auto point = cursor.pop();
+                REQUIRE_EQ(point, sgen.at(cursor.get_index()));
+                results[i].push_back(point);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::vector<std::array<double, 3>> all_points;
+    for (const auto& thread_results : results) {
+        all_points.insert(all_points.end(), thread_results.begin(), thread_results.end());
+    }
+    std::vector<std::array<double, 3>> expected;
+    for (unsigned long k = 0; k < num_threads * points_per_thread; ++k) {
+        expected.emplace_back(sgen.at(k));
+    }
+    std::ranges::sort(all_points);
+    std::ranges::sort(expected);
+    CHECK_EQ(all_points, expected);
+    CHECK_EQ(sgen.get_index(), num_threads * points_per_thread);
+
+    auto vgen = ldsgen::VdCorput(3);
+    auto cursor = ldsgen::BlockCursor(vgen, 10);
+    CHECK_EQ(cursor.get_block_size(), 10);
+    CHECK_EQ(vgen.get_index(), 0);
+    CHECK_EQ(cursor.pop(), vgen.at(0));
+    CHECK_EQ(vgen.get_index(), 10);
+}
+
+TEST_CASE("GeneratorIterator is stateless and random-access") {
+    using Iterator = decltype(std::declval<const ldsgen::Sphere&>().begin());
+    static_assert(std::random_access_iterator<Iterator>);
+    auto sgen = ldsgen::Sphere(2, 3);
+    sgen.reseed(7);
+    auto it = sgen.begin();
+    CHECK_EQ(*(it + 5), sgen.at(5));
+    CHECK_EQ(it[9], sgen.at(9));
+    it += 12;
+    CHECK_EQ(*--it, sgen.at(11));
+    CHECK_EQ(it - sgen.begin(), 11);
+    CHECK(sgen.begin() < it);
+    CHECK_EQ(sgen.get_index(), 7);
+}
+
+TEST_CASE("sequence_range") {
+    const auto hgen = ldsgen::Halton(2, 3);
+    auto points = ldsgen::sequence_range(hgen, 100, 50);
+    static_assert(std::ranges::random_access_range<decltype(points)>);
+    static_assert(std::ranges::sized_range<decltype(points)>);
+    CHECK_EQ(points.size(), 50);
+    auto xs = std::vector<double>(points.size());
+    std::ranges::transform(points, xs.begin(), [](const auto& point) { return point[0]; });
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        CHECK_EQ(xs[i], hgen.at(100 + i)[0]);
+    }
+    CHECK_EQ(hgen.get_index(), 0);
+}
+
+TEST_CASE("Generators are copyable values with fork()") {
+    static_assert(std::is_nothrow_move_constructible_v<ldsgen::VdCorput>);
+    static_assert(std::is_copy_assignable_v<ldsgen::VdCorput>);
+    static_assert(std::is_copy_constructible_v<ldsgen::Halton>);
+    static_assert(std::is_copy_constructible_v<ldsgen::Circle>);
+    static_assert(std::is_copy_constructible_v<ldsgen::Disk>);
+    static_assert(std::is_copy_constructible_v<ldsgen::Sphere>);
+    static_assert(std::is_copy_constructible_v<ldsgen::Sphere3Hopf>);
+
+    auto vgen = ldsgen::VdCorput(3);
+    vgen.reseed(5);
+    auto copy = vgen;  // a snapshot: both continue from 5 independently
+    CHECK_EQ(copy.pop(), vgen.pop());
+    CHECK_EQ(copy.pop(), vgen.pop());
+    vgen.reseed(0);
+    CHECK_EQ(copy.get_index(), 7);
+
+    // one fork per thread, stored contiguously
+    auto forks = std::vector<ldsgen::VdCorput>{};
+    for (unsigned long k = 0; k < 4; ++k) {
+        forks.push_back(vgen.fork(k * 100));
+    }
+    for (unsigned long k = 0; k < 4; ++k) {
+        CHECK_EQ(forks[k].pop(), vgen.at(k * 100));
+        CHECK_EQ(forks[k].get_index(), k * 100 + 1);
+    }
+    CHECK_EQ(vgen.get_index(), 0);
+
+    auto hgen = ldsgen::Halton(2, 3);
+    CHECK_EQ(hgen.fork(42).pop(), hgen.at(42));
+    auto sgen = ldsgen::Sphere(2, 3);
+    CHECK_EQ(sgen.fork(42).pop(), sgen.at(42));
+    auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    auto moved = std::move(shfgen);
+    CHECK_EQ(moved.fork(42).pop(), moved.at(42));
+}
@@ -1,6 +1,8 @@
 #include <doctest/doctest.h>  // for Approx, ResultBuilder, TestCase
 
+#include <cstddef>           // for size_t, ptrdiff_t
 #include <ldsgen/lds_n.hpp>  // for halton_n
+#include <stdexcept>         // for invalid_argument
 #include <vector>
 TEST_CASE("HaltonN") {
     auto hgen = ldsgen::HaltonN({2, 3, 5});
@@ -15,3 +17,85 @@ TEST_CASE("HaltonN") {
     CHECK_EQ(res[1], doctest::Approx(1.0 / 3.0));
     CHECK_EQ(res[2], doctest::Approx(1.0 / 5.0));
 }
+
+TEST_CASE("HaltonN rejects an empty base list") {
+    CHECK_THROWS_AS(ldsgen::HaltonN(std::vector<unsigned long>{}), std::invalid_argument);
+}
+
+TEST_CASE("HaltonN::fill") {
+    auto hgen = ldsgen::HaltonN({2, 3, 5, 7});
+    auto href = ldsgen::HaltonN({2, 3, 5, 7});
+    std::vector<double> values(4 * 50);
+    hgen.fill(values);
+    for (std::size_t k = 0; k < 50; ++k) {
+        const auto point = href.pop();
+        for (std::size_t j = 0; j < 4; ++j) {
+            CHECK_EQ(values[k * 4 + j], point[j]);
+        }
+    }
+    CHECK_EQ(hgen.pop(), href.pop());
+}
+
+TEST_CASE("HaltonN::at matches VdCorput::at in every dimension") {
+    auto bases = std::vector<unsigned long>(ldsgen::PRIME_TABLE.begin(),
+                                            ldsgen::PRIME_TABLE.begin() + 50);
+    bases.insert(bases.end(), {4, 6, 32, 33, 1000, 7919});
+    for (const std::size_t dim : {std::size_t(1), std::size_t(3), std::size_t(8), bases.size()}) {
+        const auto dim_bases = std::vector<unsigned long>(bases.end() - std::ptrdiff_t(dim),
+                                                          bases.end());
+        const auto hgen = ldsgen::HaltonN(dim_bases);
+        auto point = std::vector<double>(dim);
+        for (const unsigned long start : {0UL, 1000000UL, (1UL << 52U) - 5}) {
+            for (unsigned long index = start; index < start + 300; ++index) {
+                hgen.at(index, point);
+                for (std::size_t j = 0; j < dim; ++j) {
+                    REQUIRE_EQ(point[j], ldsgen::VdCorput(dim_bases[j]).at(index));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("HaltonN::pop into a buffer") {
+    auto hgen = ldsgen::HaltonN({2, 3, 5});
+    auto href = ldsgen::HaltonN({2, 3, 5});
+    auto point = std::vector<double>(3);
+    for (int i = 0; i < 10; ++i) {
+        hgen.pop(point);
+        CHECK_EQ(point, href.pop());
+    }
+}
+
+TEST_CASE("HaltonN rejects buffers of partial points") {
+    auto hgen = ldsgen::HaltonN({2, 3, 5});
+    auto short_point = std::vector<double>(2);
+    CHECK_THROWS_AS(hgen.pop(short_point), std::invalid_argument);
+    CHECK_THROWS_AS(hgen.at(0, short_point), std::invalid_argument);
+    auto ragged = std::vector<double>(3 * 10 + 1);
+    CHECK_THROWS_AS(hgen.fill(ragged), std::invalid_argument);
+    CHECK_THROWS_AS(hgen.fill(0, ragged), std::invalid_argument);
+    // the failed calls claimed no index
+    CHECK_EQ(hgen.pop(), ldsgen::HaltonN({2, 3, 5}).pop());
+
+    // a longer buffer takes the point in its first coordinates
+    auto long_point = std::vector<double>(4, -1.0);
+    hgen.at(0, long_point);
+    CHECK_EQ(long_point[3], -1.0);
+}
+
+TEST_CASE("HaltonN copies and forks") {
+    auto hgen = ldsgen::HaltonN({2, 3, 5, 7});
+    hgen.reseed(10);
+    auto copy = hgen;
+    CHECK_EQ(copy.pop(), hgen.pop());
+    auto forks = std::vector<ldsgen::HaltonN>{};
+    for (unsigned long k = 0; k < 3; ++k) {
+        forks.push_back(hgen.fork(k * 1000));
+    }
+    auto point = std::vector<double>(4);
+    for (unsigned long k = 0; k < 3; ++k) {
+        hgen.at(k * 1000, point);
+        CHECK_EQ(forks[k].pop(), point);
+    }
+    CHECK_EQ(hgen.get_dim(), 4);
+}
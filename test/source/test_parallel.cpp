@@ -0,0 +1,100 @@
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase, CHECK
+
+#include <array>                // for array
+#include <atomic>               // for atomic
+#include <cstddef>              // for size_t
+#include <ldsgen/parallel.hpp>  // for parallel_fill, parallel_for, parallel_for_static
+#include <stdexcept>            // for invalid_argument
+#include <thread>               // for thread, this_thread
+#include <vector>               // for vector
+
+TEST_CASE("parallel_for covers every item once") {
+    for (const unsigned int num_threads : {1U, 2U, 3U, 8U}) {
+        auto hits = std::vector<std::atomic<int>>(10007);
+        ldsgen::parallel_for(hits.size(), 1, num_threads, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                hits[i].fetch_add(1);
+            }
+        });
+        for (const auto& hit : hits) {
+            REQUIRE_EQ(hit.load(), 1);
+        }
+    }
+    ldsgen::parallel_for(0, 1, 4, [](std::size_t, std::size_t) { CHECK(false); });
+}
+
+TEST_CASE("parallel_fill matches the serial fill") {
+    const auto sgen = ldsgen::Sphere(2, 3);
+    auto expected = std::vector<std::array<double, 3>>(100000);
+    sgen.fill(12345, expected);
+    const auto hgen = ldsgen::HaltonN({2, 3, 5, 7, 11});
+    auto expected_n = std::vector<double>(5 * 30000);
+    hgen.fill(999, expected_n);
+    for (const unsigned int num_threads : {0U, 1U, 2U, 3U, 8U}) {
+        auto points = std::vector<std::array<double, 3>>(expected.size());
+        ldsgen::parallel_fill(sgen, 12345, points, num_threads);
+        CHECK(points == expected);
+        auto values = std::vector<double>(expected_n.size());
+        ldsgen::parallel_fill(hgen, 999, values, num_threads);
+        CHECK(values == expected_n);
+    }
+    CHECK_EQ(sgen.get_index(), 0);
+    auto ragged = std::vector<double>(expected_n.size() + 1);
+    CHECK_THROWS_AS(ldsgen::parallel_fill(hgen, 999, ragged), std::invalid_argument);
+}
+
+TEST_CASE("parallel_for reuses its threads") {
+    // the last call a thread ran a task of, which a fresh thread does not have
+    static thread_local int last_call = -1;
+    auto reused = std::atomic<bool>{false};
+    for (int call = 0; call < 10; ++call) {
+        ldsgen::parallel_for(1000, 1, 2, [&](std::size_t, std::size_t) {
+            if (last_call >= 0 && last_call < call) {
+                reused.store(true);
+            }
+            last_call = call;
+        });
+    }
+    CHECK(reused.load());
+
+    // a nested call runs on the worker that makes it
+    auto hits = std::atomic<int>{0};
+    ldsgen::parallel_for(8, 1, 2, [&](std::size_t, std::size_t) {
+        const auto outer = std::this_thread::get_id();
+        ldsgen::parallel_for(100, 1, 2, [&](std::size_t begin, std::size_t end) {
+            CHECK(std::this_thread::get_id() == outer);
+            hits.fetch_add(static_cast<int>(end - begin));
+        });
+    });
+    CHECK_EQ(hits.load(), 800);
+}
+
+TEST_CASE("parallel_for_static runs each share on the same thread every time") {
+    constexpr std::size_t num_items = 10000;
+    auto owners = std::vector<std::thread::id>(num_items);
+    ldsgen::parallel_for_static(num_items, 100, 3, [&](std::size_t begin, std::size_t end) {
+        CHECK_EQ(begin % 100, 0);
+        for (auto i = begin; i < end; ++i) {
+            owners[i] = std::this_thread::get_id();
+        }
+    });
+    auto calls = std::atomic<int>{0};
+    ldsgen::parallel_for_static(num_items, 100, 3, [&](std::size_t begin, std::size_t end) {
+        calls.fetch_add(1);
+        for (auto i = begin; i < end; ++i) {
+            REQUIRE(owners[i] == std::this_thread::get_id());
+        }
+    });
+    CHECK_LE(calls.load(), 3);
+    CHECK_THROWS(ldsgen::parallel_for_static(num_items, 1, 2, [](std::size_t, std::size_t) {
+        throw 1;
+    }));
+}
+
+TEST_CASE("parallel_for rethrows") {
+    CHECK_THROWS(ldsgen::parallel_for(100, 1, 4, [](std::size_t begin, std::size_t) {
+        if (begin == 50) {
+            throw 1;
+        }
+    }));
+}
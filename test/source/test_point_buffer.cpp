@@ -0,0 +1,76 @@
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase, CHECK
+
+#include <algorithm>                // for equal
+#include <array>                    // for array
+#include <cstddef>                  // for size_t
+#include <cstdint>                  // for uintptr_t
+#include <ldsgen/point_buffer.hpp>  // for PointBuffer, stream_fill
+#include <span>                     // for span
+#include <type_traits>              // for is_same_v
+#include <utility>                  // for move
+#include <vector>                   // for vector
+
+TEST_CASE("PointBuffer is aligned and zeroed") {
+    for (const bool huge_pages : {false, true}) {
+        auto points = ldsgen::PointBuffer<3>(10000, 2, huge_pages);
+        CHECK_EQ(points.size(), 10000);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(points.data()) % ldsgen::BUFFER_ALIGNMENT, 0);
+        const auto zero = std::array<double, 3>{};
+        CHECK_EQ(points[9999], zero);
+    }
+    auto empty = ldsgen::PointBuffer<2>(0);
+    CHECK_EQ(empty.size(), 0);
+}
+
+TEST_CASE("PointBuffer::fill matches the serial fill") {
+    const auto sgen = ldsgen::Sphere(2, 3);
+    auto expected = std::vector<std::array<double, 3>>(50000);
+    sgen.fill(77, expected);
+    for (const unsigned int num_threads : {1U, 3U}) {
+        auto points = ldsgen::PointBuffer<3>(expected.size(), num_threads, true);
+        points.fill(sgen, 77, num_threads);
+        CHECK(std::equal(points.begin(), points.end(), expected.begin()));
+        auto moved = std::move(points);
+        CHECK_EQ(moved[123], expected[123]);
+        const auto& view = moved;
+        static_assert(std::is_same_v<decltype(view[0]), const std::array<double, 3>&>);
+        CHECK_EQ(view.span()[49999], expected[49999]);
+    }
+
+    const auto vgen = ldsgen::VdCorput(3);
+    auto values = ldsgen::PointBuffer<1>(1000, 1);
+    values.fill(vgen, 5);
+    CHECK_EQ(values[0], vgen.at(5));
+    CHECK_EQ(values[999], vgen.at(1004));
+}
+
+TEST_CASE("stream_fill matches fill") {
+    const auto hgen = ldsgen::Halton(2, 3);
+    auto expected = std::vector<std::array<double, 2>>(1001);
+    hgen.fill(3, expected);
+    auto points = std::vector<std::array<double, 2>>(expected.size() + 1);
+    // an odd offset, so that the destination is not 16-byte aligned
+    auto values = std::vector<double>(2 * 1001 + 1);
+    ldsgen::stream_fill(hgen, 3, std::span(points).subspan(1));
+    CHECK(std::equal(expected.begin(), expected.end(), points.begin() + 1));
+    ldsgen::stream_copy(std::span(reinterpret_cast<const double*>(expected.data()), 2 * 1001),
+                        std::span(values).subspan(1));
+    CHECK_EQ(values[1], expected[0][0]);
+    CHECK_EQ(values[2002], expected[1000][1]);
+}
+
+TEST_CASE("stream_fill matches fill with float coordinates") {
+    const auto sgen = ldsgen::SphereF(2, 3);
+    auto expected = std::vector<std::array<float, 3>>(1000);
+    sgen.fill(0, expected);
+    auto points = std::vector<std::array<float, 3>>(expected.size() + 1);
+    // a 4-byte offset, so that the destination is not 16-byte aligned
+    ldsgen::stream_fill(sgen, 0, std::span(points).subspan(1));
+    CHECK(std::equal(expected.begin(), expected.end(), points.begin() + 1));
+
+    const auto vgen = ldsgen::VdCorputF(3);
+    auto values = std::vector<float>(1001);
+    ldsgen::stream_fill(vgen, 5, std::span(values).subspan(1));
+    CHECK_EQ(values[1], vgen.at(5));
+    CHECK_EQ(values[1000], vgen.at(1004));
+}
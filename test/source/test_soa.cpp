@@ -0,0 +1,60 @@
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase, CHECK
+
+#include <algorithm>       // for equal
+#include <array>           // for array
+#include <cstddef>         // for size_t
+#include <ldsgen/lds.hpp>  // for Sphere
+#include <ldsgen/soa.hpp>  // for transpose, to_aos, to_soa
+#include <span>            // for span
+#include <vector>          // for vector
+
+TEST_CASE("transpose") {
+    constexpr std::size_t ROWS = 150;  // not a multiple of TRANSPOSE_BLOCK
+    constexpr std::size_t COLS = 5;
+    auto matrix = std::vector<double>(ROWS * COLS);
+    for (std::size_t i = 0; i < matrix.size(); ++i) {
+        matrix[i] = double(i);
+    }
+    auto result = std::vector<double>(ROWS * COLS);
+    ldsgen::transpose(matrix, ROWS, COLS, result);
+    for (std::size_t r = 0; r < ROWS; ++r) {
+        for (std::size_t c = 0; c < COLS; ++c) {
+            CHECK_EQ(result[c * ROWS + r], matrix[r * COLS + c]);
+        }
+    }
+}
+
+TEST_CASE("to_soa and to_aos round trip") {
+    auto points = std::vector<std::array<double, 3>>(100);
+    ldsgen::Sphere(2, 3).fill(0, points);
+    auto xs = std::vector<double>(points.size());
+    auto ys = std::vector<double>(points.size());
+    auto zs = std::vector<double>(points.size());
+    ldsgen::to_soa<3>(points, {xs, ys, zs});
+    CHECK_EQ(xs[99], points[99][0]);
+    CHECK_EQ(ys[64], points[64][1]);
+    CHECK_EQ(zs[0], points[0][2]);
+    auto copy = std::vector<std::array<double, 3>>(points.size());
+    ldsgen::to_aos<3>({xs, ys, zs}, copy);
+    CHECK_EQ(copy, points);
+}
+
+TEST_CASE("to_soa, to_aos and transpose of float points") {
+    auto points = std::vector<std::array<float, 3>>(100);
+    ldsgen::SphereF(2, 3).fill(0, points);
+    auto xs = std::vector<float>(points.size());
+    auto ys = std::vector<float>(points.size());
+    auto zs = std::vector<float>(points.size());
+    ldsgen::to_soa<3, float>(points, {xs, ys, zs});
+    CHECK_EQ(ys[64], points[64][1]);
+    auto copy = std::vector<std::array<float, 3>>(points.size());
+    ldsgen::to_aos<3, float>({xs, ys, zs}, copy);
+    CHECK_EQ(copy, points);
+    auto rows = std::vector<float>{};
+    for (const auto& point : points) {
+        rows.insert(rows.end(), point.begin(), point.end());
+    }
+    auto columns = std::vector<float>(rows.size());
+    ldsgen::transpose<float>(rows, points.size(), 3, columns);
+    CHECK(std::equal(xs.begin(), xs.end(), columns.begin()));
+}
@@ -1,9 +1,15 @@
 #include <doctest/doctest.h>  // for Approx, ResultBuilder, TestCase, CHECK
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>  // for std::size_t
 #include <ldsgen/sphere_n.hpp>
+#include <memory>
 #include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 TEST_CASE("Test linspace function") {
@@ -52,6 +58,55 @@ TEST_CASE("Test get_tp function") {
     REQUIRE(tp2.size() == 300);
 }
 
+TEST_CASE("tp_table is built once and shared") {
+    const auto tp3 = ldsgen::tp_table(3);
+    CHECK_EQ(ldsgen::tp_table(3).data(), tp3.data());
+    const auto tp1 = ldsgen::get_tp(1);
+    const auto x_points = ldsgen::get_tp(0);
+    REQUIRE(tp3.size() == tp1.size());
+    for (std::size_t j = 0; j < tp3.size(); ++j) {
+        // tp(3) = (2 tp(1) - cos(x) sin(x)^2) / 3
+        const auto expected
+            = (2.0 * tp1[j] - std::cos(x_points[j]) * std::pow(std::sin(x_points[j]), 2)) / 3.0;
+        CHECK_EQ(tp3[j], doctest::Approx(expected));
+    }
+    std::vector<const double*> seen(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&seen, i] { seen[i] = ldsgen::tp_table(100).data(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto* data : seen) {
+        CHECK_EQ(data, seen[0]);
+    }
+    const auto tp100 = ldsgen::get_tp(100);
+    CHECK(std::equal(tp100.begin(), tp100.end(), seen[0]));
+}
+
+TEST_CASE("tp_table matches the recurrence across the baked tables") {
+    const auto x_points = ldsgen::linspace(0.0, ldsgen::PI, 300);
+    REQUIRE(std::ranges::equal(ldsgen::tp_table(0), x_points));
+    // past the largest baked n (64), the tables are built at run time
+    std::vector<double> prev2 = x_points;
+    std::vector<double> prev1(300);
+    std::ranges::transform(x_points, prev1.begin(), [](double x) { return -std::cos(x); });
+    for (unsigned int n = 2; n <= 80; ++n) {
+        const auto tp = ldsgen::tp_table(n);
+        REQUIRE(tp.size() == 300);
+        std::vector<double> expected(300);
+        for (std::size_t j = 0; j < 300; ++j) {
+            expected[j] = (static_cast<double>(n - 1) * prev2[j]
+                           - std::cos(x_points[j]) * std::pow(std::sin(x_points[j]), n - 1))
+                          / static_cast<double>(n);
+            REQUIRE_LE(std::abs(tp[j] - expected[j]), 1e-15);
+        }
+        CHECK_EQ(ldsgen::tp_table(n).data(), tp.data());
+        prev2 = std::exchange(prev1, expected);
+    }
+}
+
 TEST_CASE("Test Sphere3 basic functionality") {
     std::vector<unsigned long> base = {2, 3, 5};
     ldsgen::Sphere3 sgen(base);
@@ -197,6 +252,194 @@ TEST_CASE("Test SphereN reseed functionality") {
     }
 }
 
+TEST_CASE("SphereN and Sphere3 pop in place") {
+    std::vector<unsigned long> base = {2, 3, 5, 7, 11, 13};
+    ldsgen::SphereN sgen(base);
+    ldsgen::SphereN sgen_span(base);
+    std::vector<double> point(base.size() + 1);
+    for (unsigned long index = 0; index < 100; ++index) {
+        const auto expected = sgen.pop();
+        sgen_span.pop(point);
+        REQUIRE(expected == point);
+        sgen_span.at(index, point);
+        REQUIRE(expected == point);
+    }
+
+    std::vector<unsigned long> base3 = {2, 3, 5};
+    ldsgen::Sphere3 s3gen(base3);
+    ldsgen::SphereN s3ngen(base3);
+    std::vector<double> point3(4);
+    std::vector<double> point3n(4);
+    s3gen.reseed(10);
+    s3gen.pop(point3);
+    s3ngen.at(10, point3n);
+    CHECK(point3 == point3n);
+}
+
+TEST_CASE("SphereN and Sphere3 reject fewer than 3 bases") {
+    for (const auto& base : {std::vector<unsigned long>{}, std::vector<unsigned long>{2},
+                             std::vector<unsigned long>{2, 3}}) {
+        CHECK_THROWS_AS(ldsgen::SphereN(base), std::invalid_argument);
+        CHECK_THROWS_AS(ldsgen::Sphere3(base), std::invalid_argument);
+    }
+}
+
+TEST_CASE("SphereNT rejects a wrong number of bases") {
+    const std::vector<unsigned long> fewer = {2, 3, 5, 7};
+    const std::vector<unsigned long> more = {2, 3, 5, 7, 11, 13};
+    CHECK_THROWS_AS(ldsgen::SphereNT<5>(fewer), std::invalid_argument);
+    CHECK_THROWS_AS(ldsgen::SphereNT<5>(more), std::invalid_argument);
+    CHECK_THROWS_AS(ldsgen::SphereNT<3>(std::vector<unsigned long>{2, 3}), std::invalid_argument);
+}
+
+TEST_CASE("Sphere batch fill matches at()") {
+    const std::vector<unsigned long> base = {2, 3, 5, 7, 11, 13};
+    const std::size_t dim = base.size() + 1;
+    ldsgen::SphereN sgen(base);
+    std::vector<double> points(600 * dim);  // more than two blocks
+    sgen.fill(1000, points);
+    std::vector<double> point(dim);
+    for (std::size_t i = 0; i < 600; ++i) {
+        sgen.at(1000 + i, point);
+        REQUIRE(std::equal(point.begin(), point.end(), points.begin() + i * dim));
+    }
+
+    std::unique_ptr<ldsgen::SphereGen> s3gen
+        = std::make_unique<ldsgen::Sphere3>(std::vector<unsigned long>{2, 3, 5});
+    std::vector<double> points3(300 * 4);
+    std::vector<double> next(4);
+    s3gen->fill(points3);
+    s3gen->pop(next);
+    const auto* sphere3 = dynamic_cast<const ldsgen::Sphere3*>(s3gen.get());
+    for (std::size_t i = 0; i <= 300; ++i) {
+        std::vector<double> expected(4);
+        sphere3->at(i, expected);
+        const auto* got = i < 300 ? points3.data() + i * 4 : next.data();
+        REQUIRE(std::equal(expected.begin(), expected.end(), got));
+    }
+}
+
+TEST_CASE("SphereNT matches SphereN") {
+    const std::vector<unsigned long> base = {2, 3, 5, 7, 11, 13};
+    ldsgen::SphereN sgen(base);
+    ldsgen::SphereNT<6> stgen(base);
+    for (int i = 0; i < 100; ++i) {
+        const auto expected = sgen.pop();
+        const auto point = stgen.pop();
+        REQUIRE(std::equal(point.begin(), point.end(), expected.begin(), expected.end()));
+    }
+    stgen.reseed(7);
+    const auto point7 = stgen.pop();
+    CHECK(point7 == stgen.at(7));
+
+    const std::vector<unsigned long> base3 = {3, 2, 7};
+    ldsgen::Sphere3 s3gen(base3);
+    ldsgen::SphereNT<3> st3gen(base3);
+    for (int i = 0; i < 100; ++i) {
+        const auto expected = s3gen.pop();
+        const auto point = st3gen.pop();
+        REQUIRE(std::equal(point.begin(), point.end(), expected.begin(), expected.end()));
+    }
+
+    // one counter on top; the nested levels carry none
+    static_assert(alignof(ldsgen::SphereNTLevels<6, false>) < ldsgen::CACHE_LINE_SIZE);
+    static_assert(sizeof(ldsgen::SphereNT<6>)
+                  < sizeof(ldsgen::AtomicCounter) + sizeof(ldsgen::SphereNTLevels<6, false>)
+                        + ldsgen::CACHE_LINE_SIZE);
+}
+
+TEST_CASE("TpLookup matches simple_interp") {
+    const auto x_points = ldsgen::tp_table(0);
+    for (unsigned int n : {0U, 1U, 2U, 3U, 4U, 7U}) {
+        const auto tp = ldsgen::tp_table(n);
+        const auto& lookup = ldsgen::tp_lookup(n);
+        CHECK_EQ(&lookup, &ldsgen::tp_lookup(n));
+        const double t0 = tp.front();
+        const double range = tp.back() - tp.front();
+        for (int i = -10; i <= 10010; ++i) {
+            double t = t0 + range * i / 10000.0;
+            REQUIRE_EQ(lookup(t), ldsgen::simple_interp(t, tp, x_points));
+        }
+        for (double t : tp) {
+            REQUIRE_EQ(lookup(t), ldsgen::simple_interp(t, tp, x_points));
+        }
+    }
+    // the tables of larger n are not increasing next to the poles
+    for (unsigned int n : {16U, 31U}) {
+        const auto tp = ldsgen::tp_table(n);
+        const auto& lookup = ldsgen::tp_lookup(n);
+        const double range = tp.back() - tp.front();
+        for (int i = 1000; i <= 9000; ++i) {
+            double t = tp.front() + range * i / 10000.0;
+            REQUIRE_EQ(lookup(t), ldsgen::simple_interp(t, tp, x_points));
+        }
+    }
+}
+
+TEST_CASE("TpLookup::refined inverts the mapping function") {
+    const auto x_points = ldsgen::tp_table(0);
+    for (unsigned int n : {2U, 3U, 5U, 8U, 16U}) {
+        const auto tp = ldsgen::tp_table(n);
+        const auto& lookup = ldsgen::tp_lookup(n);
+        // to the rounding of the table, which the slope sin^n(x) of the
+        // mapping function amplifies towards the poles
+        for (std::size_t j = 30; j < 270; ++j) {
+            const double slope = std::pow(std::sin(x_points[j]), n);
+            REQUIRE_LE(std::abs(lookup.refined(tp[j]) - x_points[j]), 1e-14 / slope);
+        }
+        CHECK_EQ(lookup.refined(tp.front()), x_points.front());
+        CHECK_EQ(lookup.refined(tp.back()), x_points.back());
+    }
+
+    const std::vector<unsigned long> base = {2, 3, 5, 7, 11};
+    ldsgen::SphereN sgen(base);
+    ldsgen::SphereN refined_sgen(base, true);
+    ldsgen::SphereNT<5, true> refined_stgen(base);
+    std::vector<double> block(100 * 6);
+    refined_sgen.fill(0, block);
+    for (unsigned long i = 0; i < 100; ++i) {
+        std::vector<double> point(6);
+        std::vector<double> refined(6);
+        sgen.at(i, point);
+        refined_sgen.at(i, refined);
+        const auto refined_t = refined_stgen.at(i);
+        REQUIRE(std::equal(refined.begin(), refined.end(), refined_t.begin(), refined_t.end()));
+        const auto row = block.begin() + static_cast<std::ptrdiff_t>(i * 6);
+        REQUIRE(std::equal(refined.begin(), refined.end(), row));
+        double radius_sq
+            = std::inner_product(refined.begin(), refined.end(), refined.begin(), 0.0);
+        CHECK_EQ(radius_sq, doctest::Approx(1.0).epsilon(1e-10));
+        for (std::size_t k = 0; k < 6; ++k) {
+            CHECK_EQ(refined[k], doctest::Approx(point[k]).epsilon(1e-3));
+        }
+    }
+}
+
+TEST_CASE("Sphere generators copy and fork") {
+    const std::vector<unsigned long> base = {2, 3, 5, 7, 11};
+    ldsgen::SphereN sgen(base);
+    auto forks = std::vector<ldsgen::SphereN>{};
+    for (unsigned long k = 0; k < 3; ++k) {
+        forks.push_back(sgen.fork(k * 100));
+    }
+    std::vector<double> expected(6);
+    for (unsigned long k = 0; k < 3; ++k) {
+        sgen.at(k * 100, expected);
+        CHECK_EQ(forks[k].pop(), expected);
+    }
+    auto copy = forks[0];
+    CHECK_EQ(copy.pop(), forks[0].pop());
+
+    const std::vector<unsigned long> base3 = {2, 3, 5};
+    ldsgen::Sphere3 s3gen(base3);
+    std::vector<double> expected3(4);
+    s3gen.at(7, expected3);
+    CHECK_EQ(s3gen.fork(7).pop(), expected3);
+
+    ldsgen::SphereNT<5> stgen(base);
+    CHECK(stgen.fork(9).pop() == stgen.at(9));
+}
+
 TEST_CASE("Test comparison with Python implementation") {
     // Expected values from Python doctest examples
     std::vector<double> expected_sphere3
@@ -353,6 +596,48 @@ TEST_CASE("SphereWrapper thread safety") {
     CHECK_EQ(total_points, num_threads * values_per_thread);
 }
 
+TEST_CASE("SphereWrapper pop and fill claim disjoint indices") {
+    const int num_threads = 4;
+    const std::size_t points_per_fill = 100;
+    std::vector<unsigned long> base = {2, 3};
+    ldsgen::SphereWrapper sgen(base);
+    const auto reference = ldsgen::Sphere(2, 3);
+    std::vector<std::vector<double>> results(num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&sgen, &results, i]() {
+            auto& local = results[i];
+            for (int j = 0; j < 10; ++j) {
+                local.resize(local.size() + 3);
+                sgen.pop(std::span(local).last(3));
+                local.resize(local.size() + points_per_fill * 3);
+                sgen.fill(std::span(local).last(points_per_fill * 3));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // every index up to the total was claimed exactly once
+    std::vector<std::vector<double>> points;
+    for (const auto& local : results) {
+        for (std::size_t k = 0; k < local.size(); k += 3) {
+            points.emplace_back(local.begin() + static_cast<std::ptrdiff_t>(k),
+                                local.begin() + static_cast<std::ptrdiff_t>(k + 3));
+        }
+    }
+    std::vector<std::vector<double>> expected;
+    for (unsigned long index = 0; index < points.size(); ++index) {
+        const auto point = reference.at(index);
+        expected.emplace_back(point.begin(), point.end());
+    }
+    std::ranges::sort(points);
+    std::ranges::sort(expected);
+    CHECK(points == expected);
+}
+
 TEST_CASE("Concurrent reseed thread safety for sphere classes") {
     const int num_threads = 8;
     const int operations_per_thread = 25;
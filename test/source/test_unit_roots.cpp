@@ -0,0 +1,77 @@
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase, CHECK
+
+#include <array>                  // for array
+#include <cmath>                  // for cos, sin, sqrt
+#include <cstddef>                // for size_t
+#include <ldsgen/unit_roots.hpp>  // for UnitRoots, TrigFreeCircle, ...
+#include <span>                   // for span
+#include <vector>                 // for vector
+
+namespace {
+    auto distance(const auto& lhs, const auto& rhs) -> double {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < lhs.size(); ++k) {
+            sum += (lhs[k] - rhs[k]) * (lhs[k] - rhs[k]);
+        }
+        return std::sqrt(sum);
+    }
+}  // namespace
+
+TEST_CASE("UnitRoots::unit_at matches libm") {
+    for (const unsigned long base : {2UL, 3UL, 7UL, 1009UL}) {
+        const auto engine = ldsgen::UnitRoots(base);
+        for (const unsigned long first : {0UL, 1UL << 40U}) {
+            for (unsigned long index = first; index < first + 2000; ++index) {
+                const auto theta = engine.at(index) * ldsgen::TWO_PI;
+                const auto expected = std::array{std::cos(theta), std::sin(theta)};
+                CHECK_LT(distance(engine.unit_at(index), expected), 2e-14);
+            }
+        }
+    }
+}
+
+TEST_CASE("UnitOdometer::fill matches UnitRoots::unit_at") {
+    for (const unsigned long base : {2UL, 3UL, 5UL, 1009UL}) {
+        const auto engine = ldsgen::UnitRoots(base);
+        auto points = std::vector<std::array<double, 2>>(3000);
+        for (const unsigned long start : {0UL, 1UL, 1000UL, 1UL << 33U}) {
+            auto odo = engine.unit_odometer(start);
+            odo.fill(std::span(points).first(1000));
+            odo.fill(std::span(points).subspan(1000));
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                REQUIRE_EQ(points[i], engine.unit_at(start + i));
+            }
+            CHECK_EQ(engine.unit_odometer(start).pop(), engine.unit_at(start));
+        }
+    }
+}
+
+TEST_CASE("Trig-free generators match the libm ones") {
+    constexpr std::size_t NUM = 1000;
+    const auto cgen = ldsgen::Circle(3);
+    const auto tcgen = ldsgen::TrigFreeCircle(3);
+    const auto dgen = ldsgen::Disk(2, 3);
+    const auto tdgen = ldsgen::TrigFreeDisk(2, 3);
+    const auto sgen = ldsgen::Sphere(2, 3);
+    const auto tsgen = ldsgen::TrigFreeSphere(2, 3);
+    const auto shfgen = ldsgen::Sphere3Hopf(2, 3, 5);
+    const auto tshfgen = ldsgen::TrigFreeSphere3Hopf(2, 3, 5);
+    auto circle = std::vector<std::array<double, 2>>(NUM);
+    auto disk = std::vector<std::array<double, 2>>(NUM);
+    auto sphere = std::vector<std::array<double, 3>>(NUM);
+    auto sphere3 = std::vector<std::array<double, 4>>(NUM);
+    tcgen.fill(5, circle);
+    tdgen.fill(5, disk);
+    tsgen.fill(5, sphere);
+    tshfgen.fill(5, sphere3);
+    for (std::size_t i = 0; i < NUM; ++i) {
+        CHECK_EQ(circle[i], tcgen.at(5 + i));
+        CHECK_EQ(disk[i], tdgen.at(5 + i));
+        CHECK_EQ(sphere[i], tsgen.at(5 + i));
+        CHECK_EQ(sphere3[i], tshfgen.at(5 + i));
+        CHECK_LT(distance(circle[i], cgen.at(5 + i)), 1e-14);
+        CHECK_LT(distance(disk[i], dgen.at(5 + i)), 1e-14);
+        CHECK_LT(distance(sphere[i], sgen.at(5 + i)), 1e-14);
+        CHECK_LT(distance(sphere3[i], shfgen.at(5 + i)), 1e-14);
+    }
+}